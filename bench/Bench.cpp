@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include "Bench.hpp"
+
+BenchStats Bench::summarize(std::vector<double>& samples)
+{
+    if (samples.empty()) return {};
+    std::sort(samples.begin(), samples.end());
+
+    auto const percentile {
+        [&samples](double const p)
+        { return samples[static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5)]; }
+    };
+
+    double const mean { std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size()) };
+
+    double variance { 0.0 };
+    for (double const sample : samples) variance += (sample - mean) * (sample - mean);
+    variance /= static_cast<double>(samples.size());
+
+    return {
+        samples.front(),
+        percentile(0.5),
+        mean,
+        percentile(0.9),
+        samples.back(),
+        std::sqrt(variance),
+    };
+}
+
+void Bench::print(BenchResult const& result)
+{
+    std::string name { result.name };
+    if (result.planet_count) name += " [" + std::to_string(result.planet_count) + "]";
+
+    std::cout
+        << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+        << " median " << std::setw(12) << result.ns_per_op.median << " ns"
+        << "  min " << std::setw(12) << result.ns_per_op.min
+        << "  p90 " << std::setw(12) << result.ns_per_op.p90
+        << "  stddev " << std::setw(10) << result.ns_per_op.stddev << "\n";
+}
+
+bool Bench::write_json(std::filesystem::path const& path) const
+{
+    std::ofstream file { path };
+    if (!file)
+    {
+        std::cout << "[bench] [error] cannot open " << path << "\n";
+        return false;
+    }
+
+    file << std::setprecision(3) << std::fixed;
+    file << "{\n  \"samples\": " << m_options.samples << ",\n  \"benchmarks\": [\n";
+    for (size_t idx = 0; idx < m_results.size(); ++idx)
+    {
+        BenchResult const& result { m_results[idx] };
+        BenchStats const& stats { result.ns_per_op };
+
+        file
+            << "    {\"name\": \"" << result.name << "\", \"planets\": " << result.planet_count
+            << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": {\"min\": " << stats.min << ", \"median\": " << stats.median
+            << ", \"mean\": " << stats.mean << ", \"p90\": " << stats.p90
+            << ", \"max\": " << stats.max << ", \"stddev\": " << stats.stddev << "}}"
+            << (idx + 1 < m_results.size() ? ",\n" : "\n");
+    }
+    file << "  ]\n}\n";
+
+    std::cout << "[bench] wrote " << m_results.size() << " results to " << path << "\n";
+    return static_cast<bool>(file);
+}
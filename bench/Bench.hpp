@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/* Minimal microbenchmark harness:
+ * each sample runs the operation enough times to take at least
+ * min_sample_ms (calibrated once, doubles as warmup), then
+ * per operation statistics are taken over all samples */
+
+struct BenchOptions
+{
+    uint32_t warmup_samples { 3 };
+    uint32_t samples { 30 };
+    double min_sample_ms { 2.0 };
+    std::string filter; /* empty => run everything; otherwise substring of the name */
+};
+
+struct BenchStats
+{
+    double min;
+    double median;
+    double mean;
+    double p90;
+    double max;
+    double stddev;
+};
+
+struct BenchResult
+{
+    std::string name;
+    uint32_t planet_count; /* 0 => independent of the level */
+    uint64_t iterations; /* per sample */
+    BenchStats ns_per_op;
+};
+
+/* Keeps the compiler from discarding a computed value */
+template <typename T>
+void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<char const volatile*>(static_cast<void const*>(&value)));
+#endif
+}
+
+class Bench
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Bench(BenchOptions options)
+        : m_options{std::move(options)} {}
+
+    [[nodiscard]] bool is_selected(std::string const& name) const
+    { return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos; }
+
+    template <typename Operation>
+    void run(std::string const& name, uint32_t const planet_count, Operation&& op)
+    {
+        if (!is_selected(name)) return;
+
+        auto const time_batch {
+            [&op](uint64_t const count)
+            {
+                auto const start { Clock::now() };
+                for (uint64_t idx = 0; idx < count; ++idx) op();
+                return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            }
+        };
+
+        /* Calibrate */
+        uint64_t iterations { 1 };
+        while (time_batch(iterations) < m_options.min_sample_ms * 1e6 && iterations < (1ull << 30))
+            iterations *= 2;
+
+        for (uint32_t idx = 0; idx < m_options.warmup_samples; ++idx)
+            time_batch(iterations);
+
+        std::vector<double> samples;
+        samples.reserve(m_options.samples);
+        for (uint32_t idx = 0; idx < m_options.samples; ++idx)
+            samples.push_back(time_batch(iterations) / static_cast<double>(iterations));
+
+        m_results.push_back({ name, planet_count, iterations, summarize(samples) });
+        print(m_results.back());
+    }
+
+    bool write_json(std::filesystem::path const& path) const;
+
+private:
+    static BenchStats summarize(std::vector<double>& samples);
+    static void print(BenchResult const& result);
+
+    BenchOptions m_options;
+    std::vector<BenchResult> m_results;
+};
@@ -0,0 +1,380 @@
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Bench.hpp"
+#include "Fixtures.hpp"
+#include "Instances.hpp"
+#include "Scaling.hpp"
+#include "Core/Collision.hpp"
+#include "Core/LaunchSolver.hpp"
+#include "Core/Level.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/TaskGraph.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Universe.hpp"
+#include "Graphics/Color.hpp"
+#include "Graphics/Particles.hpp"
+#include "Graphics/Window.hpp"
+#include "Math/Random.hpp"
+#include "Math/Vector2.hpp"
+
+/* Microbenchmarks for the per-tick hot paths; runs against a Universe
+ * of its own (same subsystems as the game's), on synthetic levels */
+
+namespace
+{
+    constexpr uint32_t param_synthetic_seed { 0x5eed };
+    constexpr float param_synthetic_moon_chance { 0.3f };
+
+    /* Jittered grid; same planet & orbit distributions as Level::generate()
+     * but O(n), so that levels far larger than a real one can be built */
+    void generate_synthetic_level(Universe& universe, uint32_t const planet_count)
+    {
+        Random random { param_synthetic_seed };
+        Level& level { universe.get_level() };
+        auto& planets { level.get_planets() };
+
+        level.clear(); // also drops the moons of the last generated level
+        planets.reserve(planet_count); // orbits reference their planet; must not reallocate
+
+        float const max_orbit_radius {
+            World::scale_distance(level.param_planet_determinant_dist.max() * Level::param_orbit_radius_scaling_factor)
+        };
+        float const padding { level.get_config().planet_padding };
+        float const cell_size { 2.0f * max_orbit_radius + padding };
+        float const jitter { padding / 2.0f };
+
+        auto const columns { static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(planet_count)))) };
+        constexpr float v_target_sq { Player::param_target_orbital_velocity * Player::param_target_orbital_velocity };
+
+        for (uint32_t idx = 0; idx < planet_count; ++idx)
+        {
+            sf::Vector2f const position {
+                static_cast<float>(idx % columns) * cell_size + random.get(-jitter, jitter),
+                static_cast<float>(idx / columns) * cell_size + random.get(-jitter, jitter)
+            };
+
+            float const dmt { random.get(level.param_planet_determinant_dist) };
+            float const radius { World::scale_distance(dmt * Level::param_planet_radius_scaling_factor) };
+            float const orbit_radius { World::scale_distance(dmt * Level::param_orbit_radius_scaling_factor) };
+
+            planets.emplace_back(
+                position,
+                (v_target_sq * orbit_radius) / Navigation::G,
+                radius,
+                Level::param_visual_planet_color,
+                orbit_radius,
+                Level::param_visual_orbit_palette.get(
+                    static_cast<float>(random.get(level.param_visual_orbit_color_hue_dist))
+                )
+            );
+        }
+
+        level.rebuild_planet_arrays();
+
+        /* Every planet in view; so that orbit/ring_fill has rings to update */
+        float const extent { static_cast<float>(columns) * cell_size };
+        level.update_drawables(sf::View { {extent / 2.0f, extent / 2.0f}, {2.0f * extent, 2.0f * extent} });
+
+        place_player_on_first_orbit(universe);
+    }
+
+    void run_level_benchmarks(Bench& bench, Universe& universe, uint32_t const planet_count)
+    {
+        generate_synthetic_level(universe, planet_count);
+        Level& level { universe.get_level() };
+        auto& planets { level.get_planets() };
+        auto const& player { universe.get_player() };
+
+        Navigation& navigation { universe.get_navigation() };
+        bench.run("navigation/make_context", planet_count, [&navigation]
+        {
+            navigation.force_reload();
+            do_not_optimize(navigation.get_context().player_error);
+        });
+
+        /* Player is on an orbit; never colliding => full scan */
+        bench.run("collision/with_any_planet", planet_count, [&player, &level]
+        { do_not_optimize(Collision::with_any_planet(level, player.get_core())); });
+
+        bench.run("collision/with_planet", planet_count, [&player, &planets]
+        { do_not_optimize(Collision::with_planet(planets.front().get_info(), player.get_core())); });
+
+        /* Same scans as Simulation::step(); suffixed with the backend in use */
+        std::string const backend { Vector2Batch::get_backend() };
+        auto const& arrays { level.get_planet_arrays() };
+
+        bench.run("vector2/first_within:" + backend, planet_count, [&player, &arrays]
+        {
+            do_not_optimize(Vector2Batch::first_within(
+                arrays.position.span(), arrays.radius.data(), Player::param_visual_core_radius, player.get_position()
+            ));
+        });
+
+        bench.run("vector2/nearest:" + backend, planet_count, [&player, &arrays]
+        { do_not_optimize(Vector2Batch::nearest(arrays.position.span(), player.get_position()).index); });
+
+        bench.run("vector2/nearest-masked:" + backend, planet_count, [&player, &arrays]
+        {
+            do_not_optimize(Vector2Batch::nearest(
+                arrays.position.span(), player.get_position(), arrays.orbit_on.data()
+            ).index);
+        });
+
+        size_t orbit_idx { 0 };
+        bench.run("orbit/ring_fill", planet_count, [&planets, &orbit_idx]
+        {
+            planets[orbit_idx].get_orbit().clear_highlight();
+            orbit_idx = (orbit_idx + 1) % planets.size();
+        });
+
+        /* Game's view; culling over every planet (after orbit/ring_fill; releases off screen drawables) */
+        sf::View const view { Window.get_view() };
+        bench.run("level/update_drawables", planet_count, [&view, &level]
+        {
+            level.update_drawables(view);
+            do_not_optimize(level.get_visible_planets().size());
+        });
+
+        /* From the first orbit, unbudgeted; a few release phases only.
+         * The second starts inside the planet, so the pre-release walk collides on its
+         * first step; only the release at phase 0 is flown */
+        float const dt { universe.get_delta_time() };
+        Orbit const& first_orbit { planets.front().get_orbit() };
+        ShipState const in_orbit {
+            .position = player.get_position(),
+            .previous_position = player.get_position() - player.get_velocity() * dt,
+            .target = 0,
+            .previous = 0,
+            .target_mass = planets.front().get_mass(),
+            .stable = true,
+        };
+        ShipState inside_planet { in_orbit };
+        inside_planet.position = inside_planet.previous_position = first_orbit.get_origin();
+
+        constexpr uint32_t launch_candidate_count { 8 };
+        bench.run("launch/solve", planet_count, [&level, &in_orbit, dt]
+        {
+            do_not_optimize(LaunchSolver::solve(level, in_orbit, dt, launch_candidate_count, 0.0f).windows.size());
+        });
+        bench.run("launch/solve:walk-collides", planet_count, [&level, &inside_planet, dt]
+        {
+            LaunchSolution const solution { LaunchSolver::solve(level, inside_planet, dt, launch_candidate_count, 0.0f) };
+            assert(solution.complete && solution.candidates_evaluated == 1);
+            do_not_optimize(solution.windows.size());
+        });
+
+        /* Same burst as an explosion; restored from a snapshot every op */
+        ParticleEmitter& particles { universe.get_particles() };
+        particles.seed(param_synthetic_seed);
+        particles.emit(Player::param_visual_explosion_particle_count, player.get_position());
+        std::vector<ParticleSnapshot> burst(particles.get_particle_count());
+        particles.save(burst.data());
+
+        bench.run("particles/emit", planet_count, [&player, &particles]
+        { particles.emit(Player::param_visual_explosion_particle_count, player.get_position()); });
+
+        bench.run("particles/restore", planet_count, [&burst, &particles]
+        { particles.restore(burst.data(), burst.size()); });
+
+        bench.run("particles/restore+update", planet_count, [&burst, &particles]
+        {
+            particles.restore(burst.data(), burst.size());
+            particles.update();
+        });
+
+        particles.restore(burst.data(), 0);
+    }
+
+    /* Per engine; "emit" & "generate" draw what ParticleEmitter::emit()
+     * and one Level::generate() placement attempt draw */
+    template <typename Engine>
+    void run_random_benchmarks(Bench& bench, std::string const& engine_name)
+    {
+        BasicRandom<Engine> random { param_synthetic_seed };
+        ufd const unit_dist { 0.0f, 1.0f };
+        bench.run("random/float:" + engine_name, 0, [&random, &unit_dist]
+        { do_not_optimize(random.get(unit_dist)); });
+
+        std::pair<ufd, ufd> position_dist { ufd{ -1920.0f, 1920.0f }, ufd{ -1080.0f, 1080.0f } };
+        bench.run("random/vector2:" + engine_name, 0, [&random, &position_dist]
+        { do_not_optimize(random.get(position_dist)); });
+
+        bench.run("random/bool:" + engine_name, 0, [&random]
+        { do_not_optimize(random.template get<bool>()); });
+
+        std::array<float, 32> signs {};
+        bench.run("random/signs:" + engine_name, 0, [&random, &signs]
+        {
+            random.fill_signs(signs.data(), signs.size());
+            do_not_optimize(signs.back());
+        });
+
+        constexpr size_t burst_size { 7 * Player::param_visual_explosion_particle_count };
+        std::vector<float> burst(burst_size);
+        bench.run("random/emit:" + engine_name, 0, [&random, &burst, &unit_dist]
+        {
+            random.fill(burst.data(), burst.size(), unit_dist);
+            do_not_optimize(burst.back());
+        });
+
+        Level const level;
+        bench.run("random/generate:" + engine_name, 0, [&random, &position_dist, &level]
+        {
+            do_not_optimize(random.get(position_dist));
+            do_not_optimize(random.get(level.param_planet_determinant_dist));
+            do_not_optimize(random.get(level.param_visual_orbit_color_hue_dist));
+        });
+    }
+
+    void run_helper_benchmarks(Bench& bench, Universe& universe)
+    {
+        Level& level { universe.get_level() };
+        uint32_t seed { param_synthetic_seed };
+        bench.run("level/generate", level.get_config().planet_count, [&seed, &level]
+        { level.generate(seed++); });
+
+        /* Same level size, a third of the planets with moons; refits the index as they move */
+        LevelConfig const config { level.get_config() };
+        LevelConfig moon_config { config };
+        moon_config.moon_chance = param_synthetic_moon_chance;
+        level.set_config(moon_config);
+        level.generate(param_synthetic_seed);
+
+        float const dt { universe.get_delta_time() };
+        bench.run("level/advance_motion", static_cast<uint32_t>(level.get_planets().size()), [&level, dt]
+        {
+            level.advance_motion(dt);
+            do_not_optimize(level.get_motion_tick());
+        });
+
+        if (level.get_motion_tick() > 0) std::cout
+            << "[bench/motion] " << level.get_motions().size() << " moons, " << level.get_index().get_relink_count()
+            << " cell changes over " << level.get_motion_tick() << " ticks\n";
+        level.set_config(config);
+
+        run_random_benchmarks<Xoshiro128>(bench, "xoshiro128");
+        run_random_benchmarks<std::mt19937>(bench, "mt19937"); // the previous engine
+
+        double hue { 0.0 };
+        bench.run("color/hwb", 0, [&hue]
+        {
+            do_not_optimize(Color::get<Color::HWB>(hue, Level::param_visual_orbit_color_whiteness, 0.0));
+            hue = (hue < 359.0) ? hue + 1.0 : 0.0;
+        });
+
+        float palette_hue { 0.0f };
+        bench.run("color/palette", 0, [&palette_hue]
+        {
+            do_not_optimize(Level::param_visual_orbit_palette.get(palette_hue));
+            palette_hue = (palette_hue < 359.0f) ? palette_hue + 1.0f : 0.0f;
+        });
+
+        /* Same burst size as an explosion */
+        std::vector<float> hues(Player::param_visual_explosion_particle_count);
+        for (size_t idx = 0; idx < hues.size(); ++idx) hues[idx] = static_cast<float>(idx % 360);
+        std::vector<sf::Color> colors(hues.size());
+        bench.run("color/palette-fill", 0, [&hues, &colors]
+        {
+            ParticleEmitter::param_visual_particle_palette.fill(colors.data(), hues.data(), hues.size());
+            do_not_optimize(colors.back());
+        });
+
+        /* Dispatch & join overhead; the work itself is trivial */
+        std::vector<float> values(4096, 1.0f);
+        bench.run("thread_pool/parallel_for", 0, [&values]
+        {
+            ThreadPool.parallel_for(values.size(), [&values](size_t const begin, size_t const end)
+            { for (size_t idx = begin; idx < end; ++idx) values[idx] = values[idx] * 0.5f + 1.0f; });
+            do_not_optimize(values.back());
+        });
+
+        /* Same shape as a tick: a fork, a join, then the caller's chain */
+        std::array<uint32_t, 5> runs {};
+        TaskGraph graph;
+        auto const fork { graph.add([&runs] { ++runs[0]; }) };
+        auto const left { graph.add([&runs] { ++runs[1]; }, { fork }) };
+        auto const right { graph.add([&runs] { ++runs[2]; }, { fork }) };
+        auto const join { graph.add([&runs] { ++runs[3]; }, { left, right }, TaskAffinity::Caller) };
+        graph.add([&runs] { ++runs[4]; }, { join }, TaskAffinity::Caller);
+
+        bench.run("thread_pool/task_graph", 0, [&graph, &runs]
+        {
+            graph.run(&ThreadPool);
+            do_not_optimize(runs.back());
+        });
+    }
+}
+
+int main(int const argc, char* argv[])
+{
+    BenchOptions options;
+    ScalingOptions scaling_options;
+    InstancesOptions instances_options;
+    std::vector<uint32_t> planet_counts;
+    std::string json_path;
+    std::string scaling_path;
+    std::string instances_path;
+
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        std::string_view const arg { argv[idx] };
+        bool const has_value { idx + 1 < argc };
+
+        if (arg == "--planets" && has_value)
+        {
+            long const planet_count { std::strtol(argv[++idx], nullptr, 10) };
+            if (planet_count < 1)
+            {
+                std::cout << "bench: --planets needs at least 1 planet, got " << argv[idx] << "\n";
+                return 1;
+            }
+            planet_counts.push_back(static_cast<uint32_t>(planet_count));
+        }
+        else if (arg == "--samples" && has_value) options.samples = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--warmup" && has_value) options.warmup_samples = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--min-sample-ms" && has_value) options.min_sample_ms = std::strtod(argv[++idx], nullptr);
+        else if (arg == "--filter" && has_value) options.filter = argv[++idx];
+        else if (arg == "--json" && has_value) json_path = argv[++idx];
+        else if (arg == "--scaling" && has_value) scaling_path = argv[++idx];
+        else if (arg == "--max-planets" && has_value) scaling_options.max_planets = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--max-memory-mb" && has_value) scaling_options.max_memory_mb = std::strtod(argv[++idx], nullptr);
+        else if (arg == "--instances" && has_value) instances_path = argv[++idx];
+        else if (arg == "--max-instances" && has_value) instances_options.max_instances = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--step-seconds" && has_value) instances_options.seconds_per_step = std::strtof(argv[++idx], nullptr);
+        else
+        {
+            std::cout
+                << "usage: bench [--planets <n>]... [--samples <n>] [--warmup <n>]"
+                   " [--min-sample-ms <ms>] [--filter <substring>] [--json <file>]\n"
+                   "       bench --scaling <file.csv> [--max-planets <n>] [--max-memory-mb <mb>]\n"
+                   "       bench --instances <file.csv> [--max-instances <n>] [--step-seconds <s>]\n";
+            return 1;
+        }
+    }
+
+    if (!scaling_path.empty()) return run_scaling(scaling_path, scaling_options) ? 0 : 1;
+    if (!instances_path.empty()) return run_instances(instances_path, instances_options) ? 0 : 1;
+
+    Universe universe { Window.get_framerate_limit() };
+
+    uint32_t const default_planet_count { universe.get_level().get_config().planet_count };
+    if (planet_counts.empty()) planet_counts = { default_planet_count, 10 * default_planet_count };
+    if (options.samples == 0) options.samples = 1;
+
+    Bench bench { options };
+
+    /* Before the synthetic levels; generate() replaces the planets the context refers to */
+    run_helper_benchmarks(bench, universe);
+
+    for (uint32_t const planet_count : planet_counts)
+        run_level_benchmarks(bench, universe, planet_count);
+
+    if (!json_path.empty() && !bench.write_json(json_path)) return 1;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Core/Level.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/Universe.hpp"
+#include "Math/Vector2.hpp"
+
+/* Player on the first planet's orbit, moving tangentially;
+ * rebuilds the navigation context (the old one refers to the previous level) */
+inline void place_player_on_first_orbit(Universe& universe)
+{
+    auto& planets { universe.get_level().get_planets() };
+    auto& player { universe.get_player() };
+
+    Orbit const& orbit { planets.front().get_orbit() };
+    player.set_position(orbit.get_origin() + sf::Vector2f{orbit.get_radius(), 0.0f});
+    player.set_velocity({0.0f, Player::param_target_orbital_velocity});
+
+    universe.get_navigation().restore_context(planets.front());
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Instances.hpp"
+#include "Core/Level.hpp"
+#include "Core/Universe.hpp"
+
+namespace
+{
+    constexpr uint32_t param_seed { 0x1457a4ce };
+    constexpr uint32_t param_release_ticks { 240 }; /* Ticks spent stable before the scripted release */
+
+    std::vector<uint32_t> get_steps(uint32_t const max_instances, uint32_t const hardware_threads)
+    {
+        std::vector<uint32_t> steps;
+        for (uint32_t count = 1; count <= max_instances; count *= 2) steps.push_back(count);
+        if (hardware_threads <= max_instances) steps.push_back(hardware_threads);
+        steps.push_back(max_instances);
+
+        std::sort(steps.begin(), steps.end());
+        steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+        return steps;
+    }
+
+    struct InstanceResult
+    {
+        uint64_t ticks { 0 };
+        uint32_t releases { 0 };
+        uint32_t explosions { 0 };
+    };
+
+    /* One game without a window: own level & seeds, ticking until `stop`;
+     * the only input is a release once the player has been stable for a while */
+    void run_instance(
+        uint32_t const idx, std::atomic<uint32_t>& ready, std::atomic<bool> const& go,
+        std::atomic<bool> const& stop, InstanceResult& result
+    )
+    {
+        Universe universe;
+        universe.get_level().generate(param_seed + idx);
+        universe.seed({ param_seed + idx, param_seed + idx, param_seed + idx });
+
+        Navigation& navigation { universe.get_navigation() };
+        navigation.subscribe([&result](NavigationEvent const& event)
+        { if (event.type == NavigationEventType::Exploded) ++result.explosions; });
+
+        ready.fetch_add(1, std::memory_order_release);
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+        Player const& player { universe.get_player() };
+        uint32_t stable_ticks { 0 };
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            universe.update();
+            ++result.ticks;
+
+            stable_ticks = player.is(PlayerState::InStableOrbit) ? stable_ticks + 1 : 0;
+            if (stable_ticks < param_release_ticks) continue;
+
+            navigation.release_player_from_orbit();
+            stable_ticks = 0;
+            ++result.releases;
+        }
+    }
+}
+
+bool run_instances(std::filesystem::path const& path, InstancesOptions const& options)
+{
+    std::ofstream csv { path };
+    if (!csv)
+    {
+        std::cout << "[bench/instances] [error] cannot open " << path << "\n";
+        return false;
+    }
+
+    uint32_t const hardware_threads { std::max(std::thread::hardware_concurrency(), 1u) };
+    uint32_t const max_instances { options.max_instances > 0 ? options.max_instances : 2 * hardware_threads };
+
+    csv << "instances,hardware_threads,instances_per_thread,seconds,ticks,ticks_per_s,ticks_per_s_per_instance,"
+           "realtime_factor,efficiency,releases,explosions\n";
+
+    double single_ticks_per_s { 0.0 };
+    for (uint32_t const count : get_steps(max_instances, hardware_threads))
+    {
+        std::vector<InstanceResult> results(count);
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+
+        /* Levels are generated before the clock starts */
+        std::atomic<uint32_t> ready { 0 };
+        std::atomic<bool> go { false };
+        std::atomic<bool> stop { false };
+        for (uint32_t idx = 0; idx < count; ++idx)
+            threads.emplace_back(run_instance, idx, std::ref(ready), std::cref(go), std::cref(stop), std::ref(results[idx]));
+
+        while (ready.load(std::memory_order_acquire) < count) std::this_thread::yield();
+
+        auto const start { std::chrono::steady_clock::now() };
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::duration<float>{options.seconds_per_step});
+        stop.store(true, std::memory_order_relaxed);
+
+        for (auto& thread : threads) thread.join();
+        double const seconds { std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+        InstanceResult total;
+        for (auto const& result : results)
+        {
+            total.ticks += result.ticks;
+            total.releases += result.releases;
+            total.explosions += result.explosions;
+        }
+
+        double const ticks_per_s { static_cast<double>(total.ticks) / seconds };
+        double const per_instance { ticks_per_s / count };
+        if (count == 1) single_ticks_per_s = ticks_per_s;
+
+        /* 1.0 => every instance as fast as a lone one */
+        double const efficiency { single_ticks_per_s > 0.0 ? per_instance / single_ticks_per_s : 0.0 };
+        double const realtime_factor { per_instance / Universe::param_default_tick_rate };
+
+        csv
+            << count << "," << hardware_threads << "," << static_cast<double>(count) / hardware_threads << ","
+            << seconds << "," << total.ticks << "," << ticks_per_s << "," << per_instance << ","
+            << realtime_factor << "," << efficiency << "," << total.releases << "," << total.explosions << "\n";
+        csv.flush();
+
+        std::cout
+            << "[bench/instances] " << count << " instances (" << hardware_threads << " hardware threads): "
+            << ticks_per_s << " ticks/s, " << per_instance << " per instance ("
+            << realtime_factor << "x real time), efficiency " << efficiency << "\n";
+    }
+
+    return static_cast<bool>(csv);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+struct InstancesOptions
+{
+    uint32_t max_instances { 0 }; /* 0 => twice the hardware threads */
+    float seconds_per_step { 2.0f };
+};
+
+/* Steps the number of independent Universes (1, 2, 4, ... max_instances;
+ * plus one per hardware thread), each ticking on a thread of its own,
+ * recording total & per instance ticks per second per step as CSV */
+bool run_instances(std::filesystem::path const& path, InstancesOptions const& options);
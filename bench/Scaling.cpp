@@ -0,0 +1,166 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <SFML/System/Clock.hpp>
+#include "Scaling.hpp"
+#include "Fixtures.hpp"
+#include "Core/Level.hpp"
+#include "Core/Universe.hpp"
+#include "Graphics/Window.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t param_seed { 0x5ca1e };
+    constexpr uint32_t param_min_planets { 100 };
+    constexpr uint32_t param_min_frames { 3 };
+    constexpr uint32_t param_max_frames { 120 };
+    constexpr float param_min_frame_seconds { 0.5f }; /* per step; frames are timed until both minimums are met */
+    constexpr float param_step_time_budget { 120.0f }; /* seconds; larger steps are skipped once one exceeds it */
+
+    /* 0 => unknown on this platform */
+    size_t get_resident_bytes()
+    {
+#ifdef __linux__
+        std::ifstream statm { "/proc/self/statm" };
+        size_t total_pages { 0 }, resident_pages { 0 };
+        statm >> total_pages >> resident_pages;
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    std::vector<uint32_t> get_steps(uint32_t const max_planets)
+    {
+        std::vector<uint32_t> steps;
+        for (uint64_t decade = param_min_planets; decade <= max_planets; decade *= 10)
+        {
+            steps.push_back(static_cast<uint32_t>(decade));
+            if (3 * decade <= max_planets) steps.push_back(static_cast<uint32_t>(3 * decade));
+        }
+        return steps;
+    }
+
+    /* Gameplay part of Universe::update() */
+    void update_frame(Universe& universe)
+    {
+        ParticleEmitter& particles { universe.get_particles() };
+        if (particles.is_active()) return particles.update();
+
+        Navigation& navigation { universe.get_navigation() };
+        navigation.update();
+        universe.get_assist().update();
+        navigation.get_context().target_orbit.update(universe.get_player());
+        universe.get_player().update();
+    }
+
+    /* World part of Game::render() */
+    void render_frame(Universe& universe)
+    {
+        Level& level { universe.get_level() };
+
+        Window.clear();
+        level.update_drawables(Window.get_view());
+        level.draw();
+        universe.get_player().draw();
+        Window.display();
+    }
+}
+
+bool run_scaling(std::filesystem::path const& path, ScalingOptions const& options)
+{
+    std::ofstream csv { path };
+    if (!csv)
+    {
+        std::cout << "[bench/scaling] [error] cannot open " << path << "\n";
+        return false;
+    }
+
+    csv << "planets,placed,extent_scaling_factor,generate_ms,level_memory_mb,bytes_per_planet,update_ms,render_ms,frames,status\n";
+
+    Window.set_uncapped(true);
+
+    Universe universe { Window.get_framerate_limit() };
+    Level& level { universe.get_level() };
+
+    LevelConfig const base_config { level.get_config() };
+    double bytes_per_planet { 0.0 };
+    bool out_of_time { false };
+
+    for (uint32_t const planet_count : get_steps(options.max_planets))
+    {
+        LevelConfig const config { base_config.scaled_to(planet_count) };
+        auto const skip {
+            [&](char const* reason)
+            {
+                csv << planet_count << ",0," << config.extent_scaling_factor << ",,,,,,0," << reason << "\n";
+                std::cout << "[bench/scaling] " << planet_count << " planets: " << reason << "\n";
+            }
+        };
+
+        double const estimated_mb { bytes_per_planet * planet_count / (1024.0 * 1024.0) };
+        if (estimated_mb > options.max_memory_mb) { skip("skipped (memory)"); continue; }
+        if (out_of_time) { skip("skipped (time)"); continue; }
+
+        sf::Clock step_clock;
+
+        /* Generation & memory */
+        level.get_planets().clear();
+        level.get_planets().shrink_to_fit();
+        size_t const resident_before { get_resident_bytes() };
+
+        level.set_config(config);
+        sf::Clock generate_clock;
+        level.generate(param_seed);
+        float const generate_ms { generate_clock.getElapsedTime().asSeconds() * 1000.0f };
+
+        size_t const resident_after { get_resident_bytes() };
+        size_t const level_bytes { resident_after > resident_before ? resident_after - resident_before : 0 };
+
+        size_t const placed { level.get_planets().size() };
+        if (placed == 0) { skip("no planets placed"); continue; }
+        bytes_per_planet = static_cast<double>(level_bytes) / static_cast<double>(placed);
+
+        /* Per-frame cost */
+        place_player_on_first_orbit(universe);
+
+        float update_seconds { 0.0f };
+        float render_seconds { 0.0f };
+        uint32_t frames { 0 };
+        while (
+            frames < param_min_frames
+            || (update_seconds + render_seconds < param_min_frame_seconds && frames < param_max_frames)
+        ) {
+            while (Window.poll_event()) {} // keep the window responsive
+
+            sf::Clock frame_clock;
+            update_frame(universe);
+            update_seconds += frame_clock.restart().asSeconds();
+            render_frame(universe);
+            render_seconds += frame_clock.getElapsedTime().asSeconds();
+            ++frames;
+        }
+
+        float const update_ms { 1000.0f * update_seconds / static_cast<float>(frames) };
+        float const render_ms { 1000.0f * render_seconds / static_cast<float>(frames) };
+
+        csv
+            << planet_count << "," << placed << "," << config.extent_scaling_factor << ","
+            << generate_ms << "," << static_cast<double>(level_bytes) / (1024.0 * 1024.0) << ","
+            << bytes_per_planet << "," << update_ms << "," << render_ms << "," << frames << ",ok\n";
+        csv.flush(); // keep completed steps if a later one runs out of memory
+
+        std::cout
+            << "[bench/scaling] " << planet_count << " planets: generate " << generate_ms << "ms, "
+            << level_bytes / 1024 << " KiB, update " << update_ms << "ms, render " << render_ms << "ms\n";
+
+        out_of_time = step_clock.getElapsedTime().asSeconds() > param_step_time_budget;
+    }
+
+    return static_cast<bool>(csv);
+}
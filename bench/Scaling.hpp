@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+struct ScalingOptions
+{
+    uint32_t max_planets { 1000000 };
+    double max_memory_mb { 8192.0 }; /* Steps estimated to need more are skipped */
+};
+
+/* Steps the planet count 100 -> max_planets (1-3-10 sequence) at the default
+ * planet density, recording generation time, memory & per-frame update / render
+ * cost per step as CSV */
+bool run_scaling(std::filesystem::path const& path, ScalingOptions const& options);
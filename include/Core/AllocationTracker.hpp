@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "Core/ProfileScope.hpp"
+
+/* Heap allocation accounting; counts come from replacing the global
+ * operator new / delete, which only happens when ORBIT_TRACK_ALLOCATIONS
+ * is defined (CMake option of the same name). Otherwise every count stays 0.
+ *
+ * Counts are process wide (all threads); scopes are the profiler's
+ * (see ProfileTimer), so an allocation is attributed to every scope
+ * open at the time, e.g. Collision also counts towards Player; and,
+ * while tasks overlap on the pool, to those open on other threads too.
+ */
+
+struct AllocationCounts
+{
+    uint64_t allocations { 0 };
+    uint64_t deallocations { 0 };
+    uint64_t bytes { 0 }; /* allocated */
+
+    AllocationCounts& operator+=(AllocationCounts const& other)
+    {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        bytes += other.bytes;
+        return *this;
+    }
+
+    AllocationCounts operator-(AllocationCounts const& other) const
+    { return { allocations - other.allocations, deallocations - other.deallocations, bytes - other.bytes }; }
+};
+
+/* Same counts; added to from any thread */
+struct AtomicAllocationCounts
+{
+    std::atomic<uint64_t> allocations { 0 };
+    std::atomic<uint64_t> deallocations { 0 };
+    std::atomic<uint64_t> bytes { 0 };
+
+    void add(AllocationCounts const& counts)
+    {
+        allocations.fetch_add(counts.allocations, std::memory_order_relaxed);
+        deallocations.fetch_add(counts.deallocations, std::memory_order_relaxed);
+        bytes.fetch_add(counts.bytes, std::memory_order_relaxed);
+    }
+
+    AllocationCounts take() /* and reset */
+    {
+        return {
+            allocations.exchange(0, std::memory_order_relaxed),
+            deallocations.exchange(0, std::memory_order_relaxed),
+            bytes.exchange(0, std::memory_order_relaxed),
+        };
+    }
+};
+
+class AllocationTracker
+{
+public:
+    AllocationTracker() = default;
+
+#ifdef ORBIT_TRACK_ALLOCATIONS
+    constexpr static bool is_enabled { true };
+#else
+    constexpr static bool is_enabled { false };
+#endif
+
+    /* Parameters */
+    constexpr static uint32_t param_max_reports { 10 }; /* Violations reported individually */
+
+    /* Since process start */
+    [[nodiscard]] static AllocationCounts get_totals();
+
+    void begin_frame();
+
+    /* steady_state => any allocation in this frame is a violation (if checking) */
+    void end_frame(uint32_t tick, bool steady_state);
+
+    /* Any thread; see Profiler::record() */
+    void record(ProfileScope const scope, AllocationCounts const& counts)
+    { m_scope_current[static_cast<size_t>(scope)].add(counts); }
+
+    /* Steady state check; see Game::is_steady_state() */
+    void set_steady_state_check(bool const enabled) { m_steady_state_check = enabled; }
+    [[nodiscard]] bool is_checking_steady_state() const { return m_steady_state_check; }
+    [[nodiscard]] uint32_t get_violation_count() const { return m_violations; }
+
+    [[nodiscard]] AllocationCounts const& get_last_frame() const { return m_last_frame; }
+    [[nodiscard]] AllocationCounts const& get_last_frame(ProfileScope const scope) const
+    { return m_scope_last[static_cast<size_t>(scope)]; }
+
+    void print_summary() const;
+
+private:
+    void report_violation(uint32_t tick) const;
+
+    AllocationCounts m_frame_start;
+    AllocationCounts m_last_frame;
+    std::array<AtomicAllocationCounts, profile_scope_count> m_scope_current {};
+    std::array<AllocationCounts, profile_scope_count> m_scope_last {};
+    std::array<AllocationCounts, profile_scope_count> m_scope_total {};
+
+    uint32_t m_frames { 0 };
+    uint32_t m_steady_frames { 0 };
+    AllocationCounts m_steady_total;
+
+    bool m_steady_state_check { false };
+    uint32_t m_violations { 0 };
+};
+
+using AllocationTracker_t = AllocationTracker;
+extern AllocationTracker_t AllocationTracker;
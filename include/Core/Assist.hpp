@@ -2,13 +2,16 @@
 
 #include <utility>
 #include <SFML/Graphics.hpp>
+#include "Core/Navigation.hpp"
 #include "Entity/Player.hpp"
 #include "Graphics/World.hpp"
 
+class Universe;
+
 class Assist
 {
 public:
-    explicit Assist();
+    explicit Assist(Universe& universe);
 
     /* Navigation Assist Parameters;
      anything related to position/velocity should
@@ -52,17 +55,20 @@ public:
     void draw() const;
     void update();
 
+    void on_navigation_event(NavigationEvent const& event);
+    void rebase(sf::Vector2f const& shift); /* see WorldOrigin */
+
 private:
-    Player* m_player { nullptr };
+    Universe& m_universe;
 
     /* Visual */
     void init_target_radius_ring(sf::Vector2f const& position, float radius);
     void init_smoothing_ring_shape(sf::Vector2f const& position);
+    void set_smoothing_ring_active(bool active);
+
+    bool m_smoothing_ring_active { false };
 
     sf::CircleShape m_target_radius_ring;
     sf::CircleShape m_smoothing_ring_inner;
     sf::CircleShape m_smoothing_ring_outer;
 };
-
-using Assist_t = Assist;
-extern Assist_t Assist;
\ No newline at end of file
@@ -2,9 +2,11 @@
 
 #include "Entity/Planet.hpp"
 
+class Level;
+
 class Collision
 {
 public:
-    static bool with_any_planet(sf::Shape const& shape);
+    static bool with_any_planet(Level const& level, sf::Shape const& shape);
     static bool with_planet(PlanetInfo const& planet, sf::Shape const& shape);
 };
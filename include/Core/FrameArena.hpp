@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/* Bump allocator for data that only lives within a frame;
+ * one per Universe, reset at the start of every Universe::update().
+ * e.g. ParticleEmitter::emit() draws its per-attribute batches from it:
+ *
+ *   FrameVector<float> values(6 * count, &arena);
+ *
+ * Freeing the most recent allocation rewinds the bump pointer, so scoped
+ * containers hand their memory straight back; anything else is reclaimed
+ * by reset(). When the block runs out, allocations fall back to the global
+ * allocator (and go straight back to it when freed) until the next reset,
+ * which grows the block to the high-water mark.
+ *
+ * NOTE: Owning universe's thread only; nothing allocated here may outlive the frame
+ */
+
+template <typename T>
+using FrameVector = std::pmr::vector<T>;
+
+class FrameArena final : public std::pmr::memory_resource
+{
+public:
+    FrameArena();
+    ~FrameArena() override;
+
+    FrameArena(FrameArena const&) = delete;
+    FrameArena& operator=(FrameArena const&) = delete;
+
+    /* Parameters */
+    constexpr static size_t param_initial_capacity { 64 * 1024 }; // bytes
+
+    void reset();
+
+    template <typename T>
+    [[nodiscard]] FrameVector<T> make_vector(size_t const capacity = 0)
+    {
+        FrameVector<T> vector { this };
+        vector.reserve(capacity);
+        return vector;
+    }
+
+    [[nodiscard]] size_t get_used() const { return m_offset; }
+    [[nodiscard]] size_t get_capacity() const { return m_capacity; }
+    [[nodiscard]] size_t get_high_water() const { return m_high_water; } /* Largest frame so far, in bytes */
+    [[nodiscard]] uint64_t get_overflow_count() const { return m_overflow_count; }
+
+    void print() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    { return this == &other; }
+
+    std::unique_ptr<std::byte[]> m_block;
+    size_t m_capacity { 0 };
+    size_t m_offset { 0 };
+
+    size_t m_frame_high_water { 0 }; /* This frame, including overflows */
+    size_t m_high_water { 0 };
+
+    size_t m_overflow_bytes { 0 }; /* This frame; counted, not tracked (owners free them) */
+    uint64_t m_overflow_count { 0 };
+};
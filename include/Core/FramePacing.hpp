@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+
+/* Log-linear (HDR style) histogram of durations in microseconds;
+ * exact below 128us, then 64 linear sub-buckets per power of two
+ * (< 1.6% relative error), up to ~2^37us. Fixed size, never allocates. */
+class FrameTimeHistogram
+{
+public:
+    FrameTimeHistogram() = default;
+
+    constexpr static uint32_t param_sub_bucket_bits { 6 };
+    constexpr static uint32_t param_max_shift { 30 };
+
+    constexpr static uint32_t sub_bucket_count { 1u << param_sub_bucket_bits }; // per power of two
+    constexpr static uint32_t bucket_count { 2 * sub_bucket_count + param_max_shift * sub_bucket_count };
+
+    void record(uint64_t microseconds);
+    void clear() { *this = {}; }
+
+    /* Upper bound of the bucket holding the given quantile; p in [0, 1] */
+    [[nodiscard]] uint64_t get_percentile(double p) const;
+
+    [[nodiscard]] uint64_t get_count() const { return m_count; }
+    [[nodiscard]] uint64_t get_max() const { return m_max; }
+
+private:
+    [[nodiscard]] static uint32_t get_index(uint64_t microseconds);
+    [[nodiscard]] static uint64_t get_upper_bound(uint32_t index);
+
+    std::array<uint32_t, bucket_count> m_buckets {};
+    uint64_t m_count { 0 };
+    uint64_t m_max { 0 };
+};
+
+enum class FramePhase : uint8_t
+{
+    Update,
+    Render,
+    Display, /* includes waiting on the frame limiter / vsync */
+    Frame, /* all of the above */
+
+    Count
+};
+
+/* Frame time distribution per phase, and frames
+ * that missed the 1 / framerate_limit budget */
+class FramePacing
+{
+public:
+    FramePacing() = default;
+
+    constexpr static size_t phase_count { static_cast<size_t>(FramePhase::Count) };
+    constexpr static char const* phase_names[phase_count] { "update", "render", "display", "frame" };
+    constexpr static double percentiles[] { 0.50, 0.90, 0.99, 0.999 };
+
+    /* Parameters */
+    constexpr static float param_budget_slack_factor { 1.10f }; /* Frame limiter sleeps overshoot a little */
+
+    /* Visual Parameters (overlay; below the profiler's) */
+    constexpr static sf::Vector2f param_visual_overlay_origin { 40.0f, 320.0f };
+    constexpr static float param_visual_row_height { 28.0f };
+    constexpr static float param_visual_bar_max_width { 1200.0f }; // = two frame budgets
+    constexpr static sf::Color param_visual_background_color { 0, 0, 0, 160 };
+    constexpr static sf::Color param_visual_budget_color { sf::Color::Red };
+    constexpr static sf::Color param_visual_phase_colors[phase_count] {
+        {0, 130, 200}, {60, 180, 75}, {170, 110, 40}, {230, 230, 230},
+    };
+
+    /* Microseconds per phase; headless frames have no render / display */
+    void record(uint64_t update_us, uint64_t render_us, uint64_t display_us, bool rendered);
+
+    [[nodiscard]] FrameTimeHistogram const& get(FramePhase const phase) const
+    { return m_histograms[static_cast<size_t>(phase)]; }
+    [[nodiscard]] uint64_t get_budget_misses() const { return m_budget_misses; }
+
+    void print() const;
+    void draw() const;
+
+    void set_overlay_enabled(bool const enabled) { m_overlay_enabled = enabled; }
+
+private:
+    void rebuild_overlay();
+
+    std::array<FrameTimeHistogram, phase_count> m_histograms {};
+    uint64_t m_budget_misses { 0 };
+
+    /* Visual */
+    bool m_overlay_enabled { false };
+    sf::VertexArray m_overlay { sf::PrimitiveType::Triangles };
+};
+
+using FramePacing_t = FramePacing;
+extern FramePacing_t FramePacing;
@@ -1,30 +1,76 @@
 #pragma once
 
+#include <filesystem>
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/Window/Event.hpp>
-#include "Entity/Player.hpp"
+#include "Core/Level.hpp"
+#include "Core/Replay.hpp"
+#include "Core/Universe.hpp"
+#include "Graphics/Capture.hpp"
 
+struct NavigationEvent;
+
+struct GameOptions
+{
+    std::filesystem::path record_path; /* empty => not recording */
+    std::filesystem::path replay_path; /* empty => live input */
+    std::filesystem::path trace_path; /* empty => no trace dump at exit */
+    std::filesystem::path capture_path; /* empty => no frame capture (see Capture) */
+    uint32_t capture_every { 1 }; /* Capture every nth frame */
+    CaptureFormat capture_format { CaptureFormat::Png };
+    LevelConfig level; /* ignored when replaying; the replay has its own */
+    bool headless { false }; /* skip rendering (except captured frames) */
+    bool allocation_check { false }; /* report allocations in steady state frames (see AllocationTracker) */
+    bool uncapped { false }; /* no frame limiter; simulation still steps by 1 / framerate_limit */
+};
+
+/* The interactive shell around one Universe: window,
+ * input, camera, replays & capture */
 class Game
 {
 public:
-    Game();
-    void run();
+    Game() = default;
+    void run(GameOptions const& options = {});
+
+    /* Visual Parameters */
+    constexpr static float param_visual_loading_bar_width { 0.4f }; /* Fraction of the internal resolution */
+    constexpr static float param_visual_loading_bar_height { 12.0f };
+    constexpr static sf::Color param_visual_loading_bar_background { 255, 255, 255, 40 };
+    constexpr static sf::Color param_visual_loading_bar_color { sf::Color::White };
 
-    Player& get_player() { return m_player; }
-    Player const& get_player() const { return m_player; }
+    Universe& get_universe() { return m_universe; }
+    Universe const& get_universe() const { return m_universe; }
+
+    /* Number of game loop iterations so far */
+    [[nodiscard]] uint32_t get_tick() const { return m_tick; }
 
 private:
+    bool init(GameOptions const& options);
+    bool load(GameOptions const& options); /* Loading view until the level is ready; false if closed meanwhile */
+
     bool process_events();
+    void process_replay_inputs();
     void process_mouse_click(sf::Event::MouseButtonPressed const& _);
     void process_mouse_move(sf::Event::MouseMoved const& mouse);
-    void process_key(sf::Event::KeyPressed const& key);
+    void process_keypress(sf::Event::KeyPressed const& key);
+    void seek_camera(sf::Vector2f const& position);
+
+    void on_navigation_event(NavigationEvent const& event);
+    void retarget_camera();
 
     void update();
-    void render() const;
+    void render(); /* Writes culling state to the level (see Level::update_drawables) */
+    void render_loading() const;
+    void display() const; /* Separate from render(); blocks on the frame limiter */
+
+    /* A frame that should not allocate; see AllocationTracker */
+    [[nodiscard]] bool is_steady_state() const;
 
     bool m_paused { false };
     bool m_debug_mode { false };
-    Player m_player;
+    bool m_headless { false };
+    uint32_t m_tick { 0 };
+    std::filesystem::path m_trace_path;
+    ReplaySeeds m_seeds; /* Recorded once the level is ready */
+    Universe m_universe;
 };
-
-using Game_t = Game;
-extern Game_t Game;
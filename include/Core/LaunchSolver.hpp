@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Core/Simulation.hpp"
+#include "Entity/Planet.hpp"
+#include "Graphics/World.hpp"
+#include "Math/Vector2.hpp"
+
+/* A release timing that ends in a stable capture */
+struct LaunchWindow
+{
+    float release_time; // seconds from the moment of solving
+    sf::Vector2f release_position;
+
+    uint32_t target_planet; // index into Level; planet captured after release
+    float flight_time; // seconds from release to capture
+};
+
+class Level;
+class Universe;
+
+struct LaunchSolution
+{
+    std::vector<LaunchWindow> windows; // sorted by release time
+    uint32_t candidates_evaluated { 0 }; /* always the first ones, in release order */
+    bool complete { true }; /* false => frame budget ran out; windows covers the evaluated candidates only */
+};
+
+/* One solve, resumable across frames: the pre-release orbit walk and
+ * the flights pick up where the last budget ran out. Flights go in release
+ * order, so a cutoff only ever leaves out trailing candidates.
+ * Release times count from the moment the search started. */
+class LaunchSearch
+{
+public:
+    void start(ShipState const& start, float orbit_radius, float dt, uint32_t candidate_count, bool stop_at_first);
+
+    /* Advances within budget_ms (<= 0 => no budget); true once complete */
+    bool resume(Level const& level, float dt, float budget_ms);
+
+    [[nodiscard]] bool is_started() const { return m_started; }
+    [[nodiscard]] bool is_complete() const { return m_solution.complete; }
+    [[nodiscard]] LaunchSolution const& get_solution() const { return m_solution; }
+
+    void reset() { m_started = false; m_solution = {}; }
+    void rebase(sf::Vector2f const& shift); /* see WorldOrigin */
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]] bool walk(Level const& level, float dt, bool has_budget, Clock::time_point deadline);
+    bool finish_walk(); /* Every way out of a finished walk; sizes the flight slots */
+    void fly(Level const& level, float dt, bool has_budget, Clock::time_point deadline);
+    void collect();
+
+    bool m_started { false };
+    bool m_stop_at_first { false };
+    uint32_t m_candidate_count { 0 };
+    uint32_t m_period_ticks { 0 };
+
+    /* Pre-release walk */
+    ShipState m_ship;
+    uint32_t m_tick { 0 };
+    bool m_walked { false };
+
+    /* Flights; one per release phase */
+    std::vector<ShipState> m_releases;
+    std::vector<uint32_t> m_release_ticks;
+    std::vector<std::optional<LaunchWindow>> m_results;
+    std::vector<uint8_t> m_evaluated;
+    size_t m_evaluated_prefix { 0 }; /* [0, prefix) all evaluated */
+
+    LaunchSolution m_solution;
+};
+
+class LaunchSolver
+{
+public:
+    explicit LaunchSolver(Universe& universe) : m_universe{universe} {}
+
+    /* Solver Parameters */
+    constexpr static uint32_t param_candidate_count { 96 }; // release phases sampled over one orbital period
+    constexpr static float param_flight_horizon { 6.0f }; // seconds simulated after release
+    constexpr static float param_capture_hold_time { 0.5f }; // seconds stable before it counts as a capture
+    constexpr static float param_escape_distance { World::scale_distance(2000.0f) }; // beyond target orbit
+    constexpr static float param_frame_budget_ms { 4.0f };
+    constexpr static uint32_t param_budget_check_interval { 32 }; // steps between deadline checks
+
+    /* Playability Check Parameters */
+    constexpr static uint32_t param_playability_candidate_count { 24 };
+    constexpr static float param_playability_budget_ms { 2.0f }; // per tick, on top of the hint's
+
+    /* Visual Parameters */
+    constexpr static float param_visual_marker_length { World::scale_distance(40.0f) };
+    constexpr static sf::Color param_visual_marker_color { sf::Color::Cyan };
+
+    /* Samples release phases over one orbital period starting from `start`
+     * (a ship in orbit); each candidate is simulated on the ThreadPool.
+     * budget_ms <= 0 => no budget; stop_at_first => any window will do.
+     * One go; the in-game hint resumes a LaunchSearch instead */
+    [[nodiscard]] static LaunchSolution solve(
+        Level const& level, ShipState const& start, float dt,
+        uint32_t candidate_count = param_candidate_count,
+        float budget_ms = param_frame_budget_ms,
+        bool stop_at_first = false
+    );
+
+    /* Solves from every planet's orbit, a budget per tick (see update());
+     * logs the planets the player can never leave (dead ends) once done */
+    void start_playability_check();
+    [[nodiscard]] bool is_checking_playability() const { return m_playability_planet != ShipState::npos; }
+
+    /* In-game hint: marks release points on the player's current orbit */
+    void draw() const;
+    void update();
+
+    void toggle_hint() { m_hint_enabled = !m_hint_enabled; m_solved_for = ShipState::npos; m_search.reset(); m_markers.clear(); }
+    [[nodiscard]] bool is_hint_enabled() const { return m_hint_enabled; }
+    void rebase(sf::Vector2f const& shift); /* see WorldOrigin */
+    void carry(sf::Vector2f const& shift); /* The hint only; its orbit moved (see Level::advance_motion()) */
+
+private:
+    void update_hint();
+    void update_playability();
+    void init_markers(sf::Vector2f const& origin);
+
+    Universe& m_universe;
+    bool m_hint_enabled { false };
+    uint32_t m_solved_for { ShipState::npos }; /* Target of m_search; complete or not */
+    LaunchSearch m_search;
+
+    /* Playability check */
+    uint32_t m_playability_planet { ShipState::npos }; /* Being solved from; npos => idle */
+    uint32_t m_playability_seed { 0 }; /* Level it runs on; a new level cancels it */
+    Xoshiro128 m_playability_random; /* Jumped once per planet; each start gets a stream of its own */
+    LaunchSearch m_playability_search;
+    std::vector<uint32_t> m_dead_ends;
+
+    /* Visual */
+    sf::VertexArray m_markers { sf::PrimitiveType::Lines };
+};
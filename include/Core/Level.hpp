@@ -1,31 +1,117 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "Entity/Planet.hpp"
 #include "Entity/Player.hpp"
+#include "Graphics/Color.hpp"
+#include "Graphics/PlanetDrawable.hpp"
+#include "Core/SpatialIndex.hpp"
 #include "Graphics/World.hpp"
+#include "Math/Kepler.hpp"
 #include "Math/Vector2.hpp"
 #include "Math/Random.hpp"
 
+/* Runtime level size; part of a replay (see Replay) */
+struct LevelConfig
+{
+    uint32_t planet_count { 500 };
+    float extent_scaling_factor { 8.0f }; /* Planets are placed within +-(1920, 1080) * factor */
+    float planet_padding { World::scale_distance(250.0f) }; /* Minimum gap between orbits */
+    float moon_chance { 0.0f }; /* [0, 1]; planets that get moons on Kepler orbits. 0 => nothing moves */
+
+    /* Same planet density, different planet count */
+    [[nodiscard]] LevelConfig scaled_to(uint32_t count) const;
+};
+
+/* Structure of arrays copy of the planets, for Vector2Batch scans;
+ * same indices as Level::get_planets() */
+struct PlanetArrays
+{
+    Vector2Array position;
+    std::vector<float> radius;
+    std::vector<uint8_t> orbit_on; /* Kept in sync by the orbits themselves */
+    std::vector<float> visual_radius; /* Outermost ring; for culling */
+};
+
+/* A moon; travels around its parent (a planet that does not move itself) */
+struct PlanetMotion
+{
+    uint32_t planet;
+    uint32_t parent;
+    KeplerOrbit orbit;
+};
+
 class Level
 {
 public:
     Level() = default;
+    ~Level();
+
+    /* Takes effect on the next generate() */
+    void set_config(LevelConfig const& config) { m_config = config; }
+    [[nodiscard]] LevelConfig const& get_config() const { return m_config; }
+
+    void generate(uint32_t seed);
+
+    /* Same, on a worker thread; the planets must not be touched
+     * until is_generated(), then finish_generate() (main thread) takes them over */
+    void generate_async(uint32_t seed);
+    [[nodiscard]] bool is_generated() const { return m_generated.load(std::memory_order_acquire); }
+    [[nodiscard]] float get_generate_progress() const; /* [0, 1]; safe to poll while generating */
+    void finish_generate();
+
+    /* Once per rendered frame, before draw(): planets within the view get a drawable
+     * (from the pool) the first time they show up; planets that have been off screen
+     * for param_drawable_release_frames give theirs back */
+    void update_drawables(sf::View const& view);
+    void draw() const; /* Visible planets only */
+
+    [[nodiscard]] std::vector<uint32_t> const& get_visible_planets() const { return m_visible; }
+    void print_drawables() const;
 
-    void generate();
+    [[nodiscard]] uint32_t get_seed() const { return m_seed; }
 
     std::vector<Planet>& get_planets() { return m_planets; }
+    std::vector<Planet> const& get_planets() const { return m_planets; }
+    /* see WorldOrigin; `cell` is the new origin. Planets that hold still are put
+     * back at their absolute place relative to it; moons are shifted (they
+     * follow their parent's exact place from the next tick on) */
+    void rebase(sf::Vector2f const& shift, sf::Vector2i const& cell);
+
+    [[nodiscard]] PlanetArrays const& get_planet_arrays() const { return m_planet_arrays; }
+
+    /* Over the planet positions; refit as moons move */
+    [[nodiscard]] SpatialIndex const& get_index() const { return m_index; }
+    [[nodiscard]] float get_max_planet_radius() const { return m_max_planet_radius; }
+
+    /* Moons to where they are one tick later; positions come from
+     * the level's clock (tick * dt), not from the previous ones */
+    void advance_motion(float dt);
+    void set_motion_tick(uint32_t tick, float dt); /* e.g. back to a snapshot; see Rewind */
+    [[nodiscard]] uint32_t get_motion_tick() const { return m_motion_tick; }
+    [[nodiscard]] bool has_motion() const { return !m_motions.empty(); }
+    [[nodiscard]] std::vector<PlanetMotion> const& get_motions() const { return m_motions; }
+
+    /* How far a planet moved over the last tick; zero for planets that hold still */
+    [[nodiscard]] sf::Vector2f get_displacement(uint32_t const planet_idx) const
+    { return m_displacement.get(planet_idx); }
+
+    /* Building a level by hand: clear() (no planets, nothing moving),
+     * add the planets, then rebuild_planet_arrays() */
+    void clear();
+
+    /* After adding/removing planets other than through generate();
+     * also takes back every drawable */
+    void rebuild_planet_arrays();
 
     /* Level Generation Parameters */
-    constexpr static uint32_t param_planet_count { 500 };
-    constexpr static float param_planet_padding { World::scale_distance(250.0f) };
+    constexpr static uint32_t param_max_consecutive_rejections { 100000 }; /* Level is full; give up */
+    constexpr static uint32_t param_index_cells_per_planet { 1 }; /* Bounds the index's cell count */
 
-    constexpr static float param_position_dist_scaling_factor { 8.0f };
-    std::pair<ufd, ufd> const param_planet_position_dist {
-        ufd { -1920.f * param_position_dist_scaling_factor, +1920.f * param_position_dist_scaling_factor }, // x
-        ufd { -1080.f * param_position_dist_scaling_factor, +1080.f * param_position_dist_scaling_factor } // y
-    };
+    constexpr static uint32_t param_drawable_release_frames { 240 }; /* Off screen for this long => back to the pool */
 
     /* Planet Determinant: Serves as a single random seed to
      * generate both the planet's & it's orbit's radii.
@@ -34,17 +120,58 @@ public:
     constexpr static float param_planet_radius_scaling_factor { 8.0f };
     constexpr static float param_orbit_radius_scaling_factor { 20.0f };
 
+    /* Moons: smaller determinants than any planet, so always lighter than their parent.
+     * Each gets a lane of its own around the parent, clear of its orbit & the other lanes */
+    constexpr static uint32_t param_max_moons { 2 };
+    urd<float> const param_moon_determinant_dist { 4.0f, 6.5f };
+    urd<float> const param_moon_eccentricity_dist { 0.0f, 0.2f };
+    constexpr static float param_moon_time_scale { 0.15f }; /* Slower than real Kepler; so that a moon can be caught */
+
     /* Visual Parameters */
     constexpr static sf::Color param_visual_planet_color { sf::Color::White };
     urd<double> const param_visual_orbit_color_hue_dist { 0.0, 359.0 };
     constexpr static double param_visual_orbit_color_whiteness { 65.0 };
     constexpr static double param_visual_orbit_color_blackness { 0.0 };
+    constexpr static ColorPalette param_visual_orbit_palette {
+        ColorPalette::make<Color::HWB>(param_visual_orbit_color_whiteness, param_visual_orbit_color_blackness)
+    };
 
 
 private:
+    [[nodiscard]] std::pair<ufd, ufd> get_position_dist() const;
+    void place(uint32_t seed);
+    void update_motion(float dt);
+    void build_index();
+
+    LevelConfig m_config;
     std::vector<Planet> m_planets;
+    PlanetArrays m_planet_arrays;
+    SpatialIndex m_index;
+    float m_max_planet_radius { 0.0f };
+    float m_max_visual_radius { 0.0f };
     Random m_random;
+    uint32_t m_seed { 0 };
+
+    /* Drawables */
+    PlanetDrawablePool m_drawable_pool;
+    std::vector<uint32_t> m_visible; /* Planet indices, in draw order */
+    std::vector<uint32_t> m_drawn; /* Planet indices holding a drawable */
+    std::vector<uint32_t> m_last_visible_frame; /* Per planet */
+    uint32_t m_frame { 0 };
+
+    /* Origin; see rebase() */
+    sf::Vector2i m_origin_cell; /* Positions are relative to it */
+    std::vector<sf::Vector2<double>> m_absolute_positions; /* Per planet; where it was placed */
+
+    /* Motion */
+    std::vector<PlanetMotion> m_motions; /* Parents come before their moons */
+    std::vector<uint8_t> m_moving; /* Per planet; 1 => a moon */
+    Vector2Array m_displacement; /* Per planet */
+    uint32_t m_motion_tick { 0 };
+
+    /* Async generation */
+    std::thread m_generator;
+    std::atomic<bool> m_generated { false };
+    std::atomic<uint32_t> m_placed_count { 0 };
 };
 
-using Level_t = Level;
-extern Level_t Level;
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/* Asynchronous logger; a log line is formatted straight into a slot
+ * of the calling thread's lock-free ring (single producer, single consumer)
+ * and written to std::cout by a background thread.
+ *
+ *   ORBIT_LOG(Warning, "entity/player") << "drift velocity clamped: " << v;
+ *   ORBIT_LOG_EVERY(Warning, "entity/player", 1000) << ...; // at most once per second per call site
+ *
+ * Lines below ORBIT_LOG_MIN_LEVEL are compiled out; lines below
+ * the runtime level cost a relaxed load. A full ring drops lines (counted).
+ * Lines are ordered per thread, not across threads.
+ */
+
+enum class LogLevel : uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error,
+};
+
+#ifndef ORBIT_LOG_MIN_LEVEL
+#define ORBIT_LOG_MIN_LEVEL 0 /* LogLevel::Debug */
+#endif
+
+struct LogRecord
+{
+    constexpr static size_t param_text_capacity { 224 };
+
+    char const* tag;
+    uint32_t suppressed; /* Rate limited lines since the last one emitted */
+    uint16_t length;
+    LogLevel level;
+    std::array<char, param_text_capacity> text;
+};
+
+class LogRing
+{
+public:
+    constexpr static uint32_t param_capacity { 256 }; // records; power of two
+
+    /* Producer (owning thread) */
+    [[nodiscard]] LogRecord* try_acquire()
+    {
+        uint32_t const head { m_head.load(std::memory_order_relaxed) };
+        if (head - m_tail.load(std::memory_order_acquire) == param_capacity)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_records[head % param_capacity];
+    }
+
+    void commit() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /* Consumer (logger thread); returns the number of records drained */
+    template <typename Sink>
+    uint32_t drain(Sink&& sink)
+    {
+        uint32_t tail { m_tail.load(std::memory_order_relaxed) };
+        uint32_t const head { m_head.load(std::memory_order_acquire) };
+        for (uint32_t idx = tail; idx != head; ++idx) sink(m_records[idx % param_capacity]);
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    [[nodiscard]] uint64_t take_dropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::array<LogRecord, param_capacity> m_records;
+    alignas(64) std::atomic<uint32_t> m_head { 0 };
+    alignas(64) std::atomic<uint32_t> m_tail { 0 };
+    std::atomic<uint64_t> m_dropped { 0 };
+};
+
+class Log
+{
+public:
+    Log();
+    ~Log(); /* Drains every ring; define before anything that logs on destruction */
+
+    Log(Log const&) = delete;
+    Log& operator=(Log const&) = delete;
+
+    /* Parameters */
+    constexpr static auto param_flush_interval { std::chrono::milliseconds{5} };
+
+    void set_level(LogLevel const level) { m_level.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] bool is_enabled(LogLevel const level) const
+    { return level >= m_level.load(std::memory_order_relaxed); }
+
+    /* Blocks until everything logged so far has been written */
+    void flush();
+
+    [[nodiscard]] LogRing& get_thread_ring();
+
+private:
+    void run();
+    void drain();
+    static void write(LogRecord const& record);
+
+    std::atomic<LogLevel> m_level { LogLevel::Debug };
+
+    std::mutex m_mutex; /* Guards m_rings (registration) & the wakeup */
+    std::condition_variable m_wakeup;
+    std::vector<std::unique_ptr<LogRing>> m_rings;
+    bool m_running { true };
+    uint64_t m_flush_requests { 0 };
+    uint64_t m_flushes_done { 0 };
+    std::condition_variable m_flushed;
+
+    std::thread m_thread;
+};
+
+using Log_t = Log;
+extern Log_t Log;
+
+/* At most one line per interval per call site; see ORBIT_LOG_EVERY */
+class LogRateLimit
+{
+public:
+    explicit LogRateLimit(int64_t const interval_ms)
+        : m_interval_ns{interval_ms * 1000000} {}
+
+    bool allow()
+    {
+        int64_t const now {
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        };
+        int64_t next { m_next_ns.load(std::memory_order_relaxed) };
+        if (now >= next && m_next_ns.compare_exchange_strong(next, now + m_interval_ns, std::memory_order_relaxed))
+            return true;
+
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    [[nodiscard]] uint32_t take_suppressed() { return m_suppressed.exchange(0, std::memory_order_relaxed); }
+
+private:
+    int64_t const m_interval_ns;
+    std::atomic<int64_t> m_next_ns { 0 };
+    std::atomic<uint32_t> m_suppressed { 0 };
+};
+
+/* One log line; formats into the ring slot, committed on destruction */
+class LogLine
+{
+public:
+    LogLine(LogLevel level, char const* tag, uint32_t suppressed = 0);
+    ~LogLine();
+
+    LogLine(LogLine const&) = delete;
+    LogLine& operator=(LogLine const&) = delete;
+
+    LogLine& operator<<(std::string_view text);
+    LogLine& operator<<(char const* text) { return *this << std::string_view{text}; }
+    LogLine& operator<<(std::string const& text) { return *this << std::string_view{text}; }
+    LogLine& operator<<(std::filesystem::path const& path)
+    {
+#ifdef _WIN32
+        return *this << path.string(); /* Wide; converted */
+#else
+        return *this << std::string_view{path.native()}; /* Already narrow; no copy */
+#endif
+    }
+    LogLine& operator<<(char character) { return *this << std::string_view{&character, 1}; }
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(double value);
+    LogLine& operator<<(float const value) { return *this << static_cast<double>(value); }
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>, int> = 0>
+    LogLine& operator<<(T const value) { return write_signed(value); }
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>, int> = 0>
+    LogLine& operator<<(T const value) { return write_unsigned(value); }
+
+private:
+    LogLine& write_signed(int64_t value);
+    LogLine& write_unsigned(uint64_t value);
+
+    LogRing* m_ring { nullptr };
+    LogRecord* m_record { nullptr };
+};
+
+/* Compares levels, not ints; with ORBIT_LOG_MIN_LEVEL 0 the int compare
+ * is always true, which -Wtype-limits reports at every call site */
+constexpr bool log_level_compiled_in(LogLevel const level)
+{
+    return level >= static_cast<LogLevel>(ORBIT_LOG_MIN_LEVEL);
+}
+
+#define ORBIT_LOG_LEVEL_ENABLED(level) \
+    (log_level_compiled_in(LogLevel::level))
+
+/* Each macro is a single statement that runs its body at most once (a for,
+ * not an if/else), so `if (x) ORBIT_LOG(...) << ...; else ...` pairs the else
+ * with the if. Operands are only evaluated for lines that are written */
+#define ORBIT_LOG(level, tag) \
+    for (bool orbit_log_once { ORBIT_LOG_LEVEL_ENABLED(level) && Log.is_enabled(LogLevel::level) }; \
+         orbit_log_once; orbit_log_once = false) \
+        LogLine { LogLevel::level, tag }
+
+/* One rate limit per call site; the static lives in the (per site) lambda */
+#define ORBIT_LOG_EVERY(level, tag, interval_ms) \
+    for (LogRateLimit* orbit_log_rate_limit { \
+             (ORBIT_LOG_LEVEL_ENABLED(level) && Log.is_enabled(LogLevel::level)) \
+             ? &[]() -> LogRateLimit& { static LogRateLimit limit { interval_ms }; return limit; }() \
+             : nullptr \
+         }; \
+         orbit_log_rate_limit && orbit_log_rate_limit->allow(); orbit_log_rate_limit = nullptr) \
+        LogLine { LogLevel::level, tag, orbit_log_rate_limit->take_suppressed() }
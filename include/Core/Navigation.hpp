@@ -1,8 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <optional>
-#include "Core/Game.hpp"
+#include <vector>
 #include "Entity/Planet.hpp"
 #include "Entity/Orbit.hpp"
 #include "Entity/Player.hpp"
@@ -19,6 +20,10 @@ struct NavigationContext
      * target orbit */
     float const player_error;
 
+    /* Player's classification (see Player::classify);
+     * computed once per context, queried through Player::is() */
+    PlayerStateMask const player_state;
+
     /* References to the target planet
      * and target orbit; towards which
      * the player is being pulled.
@@ -46,10 +51,36 @@ struct NavigationContext
 };
 
 
+enum class NavigationEventType
+{
+    TargetChanged, /* planet: new target; other: old target (may be null) */
+    PreviousChanged, /* planet: new previous planet (respawn point) */
+
+    EnteredSmoothingRing,
+    LeftSmoothingRing,
+    EnteredFarOutside,
+    LeftFarOutside,
+
+    Captured, /* Player became stable around the target planet */
+    Escaped, /* Player left the target orbit's region */
+    Exploded,
+};
+
+struct NavigationEvent
+{
+    NavigationEventType type;
+    Planet* planet { nullptr };
+    Planet* other { nullptr };
+};
+
+using NavigationListener = std::function<void(NavigationEvent const&)>;
+
+class Universe;
+
 class Navigation
 {
 public:
-    Navigation() = default;
+    explicit Navigation(Universe& universe) : m_universe{universe} {}
 
     void force_reload() { m_context.emplace(make_context()); }
 
@@ -66,18 +97,37 @@ public:
 
     [[nodiscard]] bool has_context() const { return m_context.has_value(); }
 
+    /* Player's classification as of the last published transitions;
+     * compare against the current context to detect state transitions */
+    [[nodiscard]] PlayerStateMask get_previous_player_state() const { return m_previous_player_state; }
+
     void release_player_from_orbit();
 
+    /* Transition events are published once per update();
+     * comparing against what was last published, so changes made
+     * between updates (release, respawn, rewind) are not missed */
+    void subscribe(NavigationListener listener) { m_listeners.push_back(std::move(listener)); }
+    void on_player_exploded();
+
+    /* Rebuilds the context from the player's current state;
+     * the previous planet is history, so it has to be supplied */
+    void restore_context(Planet& previous_planet);
+
 private:
-    [[nodiscard]] NavigationContext make_context() const;
+    [[nodiscard]] NavigationContext make_context(Planet* restored_previous_planet = nullptr) const;
 
-    [[nodiscard]] std::pair<sf::Vector2f, sf::Vector2f> ctx_get_velocity_components() const;
+    void publish(NavigationEvent const& event) const;
+    void publish_transitions();
+
+    [[nodiscard]] std::pair<sf::Vector2f, sf::Vector2f> ctx_get_velocity_components(Planet const& target, bool is_restoring) const;
     Planet& ctx_get_previous_planet(Planet& current_target_ref) const;
 
     std::optional<NavigationContext> m_context;
-    Player* m_player { nullptr };
-
-};
-
-using Navigation_t = Navigation;
-extern Navigation_t Navigation;
\ No newline at end of file
+    Universe& m_universe;
+    PlayerStateMask m_previous_player_state { 0 };
+
+    /* Events */
+    std::vector<NavigationListener> m_listeners;
+    Planet* m_published_target { nullptr };
+    Planet* m_published_previous { nullptr };
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <deque>
+#include <SFML/Graphics.hpp>
+#include "Entity/Planet.hpp"
+#include "Graphics/World.hpp"
+#include "Math/Vector2.hpp"
+
+/* A single forward-simulated tick;
+ * `puller` is the planet whose orbit
+ * was used to advance from this step
+ * (nullptr until the next step is simulated) */
+struct PredictionStep
+{
+    sf::Vector2f position;
+    sf::Vector2f previous_position;
+    Planet const* puller { nullptr };
+};
+
+class Universe;
+
+class Prediction
+{
+public:
+    explicit Prediction(Universe& universe) : m_universe{universe} {}
+
+    /* Prediction Parameters */
+    constexpr static float param_prediction_duration { 3.0f }; // seconds
+    constexpr static uint32_t param_prediction_framerate { 120 }; // matches Window's framerate limit
+    constexpr static uint32_t param_prediction_step_count {
+        static_cast<uint32_t>(param_prediction_duration * param_prediction_framerate)
+    };
+
+    /* Max distance between the player and the cached
+     * prediction before the whole path is re-simulated;
+     * small corrections (i.e. by Assist) are absorbed */
+    constexpr static float param_prediction_divergence_tolerance { World::scale_distance(2.0f) };
+
+    /* In a stable orbit, the release preview mostly depends on where along
+     * the orbit the player is; the cached path is turned round with the player
+     * up to the first step another planet would pull (re-simulated from there),
+     * and re-simulated whole once it has turned this far, since the turned
+     * steps only approximate the pulls of the planets they pass */
+    constexpr static float param_release_preview_refresh_angle { 0.25f }; // radians
+
+    /* Extra clearance added to planet radii
+     * when checking the predicted path for collisions */
+    constexpr static float param_prediction_collision_padding { 20.0f }; // ~ Player::param_visual_core_radius
+
+    /* Visual Parameters */
+    constexpr static sf::Color param_visual_path_color { sf::Color::White };
+    constexpr static uint8_t param_visual_path_alpha { 120 };
+
+    void draw() const;
+    void update();
+
+    void clear();
+    void rebase(sf::Vector2f const& shift); /* Keeps the cached steps; e.g. carried by a moving planet */
+
+    [[nodiscard]] std::deque<PredictionStep> const& get_steps() const { return m_steps; }
+
+private:
+    /* Nearest planet with an ON orbit, pretending
+     * the excluded planet's orbit is OFF (and every other orbit is ON).
+     * Returns nullptr if `position` lies inside any planet. */
+    [[nodiscard]] Planet const* find_puller(sf::Vector2f const& position) const;
+
+    /* Re-checks the pullers of cached steps against the current
+     * orbit configuration; drops everything after the first divergent step */
+    void truncate_at_first_divergence();
+
+    /* Turns the cached release preview to the player's phase on its orbit;
+     * their pullers are re-checked after (truncate_at_first_divergence());
+     * false => re-simulate it instead */
+    [[nodiscard]] bool carry_release_preview();
+
+    void extend();
+    void rebuild_path();
+
+    Universe& m_universe;
+    std::deque<PredictionStep> m_steps;
+    Planet const* m_excluded { nullptr };
+    bool m_terminated { false }; /* path ended in a collision */
+    float m_preview_turn { 0.0f }; /* radians; since the release preview was simulated */
+
+    /* Visual */
+    sf::VertexArray m_path { sf::PrimitiveType::LineStrip };
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* Hot path scopes; shared by the profiler & the allocation tracker */
+enum class ProfileScope : uint8_t
+{
+    /* Universe::update */
+    Navigation,
+    Assist,
+    Orbit,
+    Player,
+    Collision, /* nested in Player */
+    Particles,
+    Prediction,
+    LaunchSolver,
+    Swarm,
+    Rewind,
+    Motion,
+
+    /* Game::render */
+    RenderWorld,
+    RenderOverlay,
+    Display, /* includes waiting on the frame limiter */
+
+    Count
+};
+
+inline constexpr size_t profile_scope_count { static_cast<size_t>(ProfileScope::Count) };
+
+inline constexpr char const* profile_scope_names[profile_scope_count] {
+    "Navigation", "Assist", "Orbit", "Player", "Collision", "Particles",
+    "Prediction", "LaunchSolver", "Swarm", "Rewind", "Motion",
+    "RenderWorld", "RenderOverlay", "Display",
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <SFML/Graphics.hpp>
+#include "Core/AllocationTracker.hpp"
+#include "Core/ProfileScope.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Trace.hpp"
+
+/* Hot path profiler; scoped timers accumulate per frame,
+ * frames are kept in a ring buffer for rolling statistics.
+ * Timers compile to nothing unless ORBIT_PROFILER (see CMakeLists.txt;
+ * off for Release builds) or ORBIT_TRACK_ALLOCATIONS is defined */
+
+class Profiler
+{
+public:
+    Profiler() = default;
+
+    constexpr static size_t scope_count { profile_scope_count };
+
+    /* Parameters */
+    constexpr static uint32_t param_frame_history { 240 };
+
+    /* Visual Parameters (overlay; in internal resolution pixels) */
+    constexpr static sf::Vector2f param_visual_overlay_origin { 40.0f, 40.0f };
+    constexpr static float param_visual_graph_column_width { 3.0f };
+    constexpr static float param_visual_graph_height { 240.0f }; // = one frame budget
+    constexpr static float param_visual_bar_row_height { 18.0f };
+    constexpr static float param_visual_bar_max_width { 600.0f }; // = one frame budget
+    constexpr static float param_visual_panel_spacing { 40.0f };
+    constexpr static sf::Color param_visual_background_color { 0, 0, 0, 160 };
+    constexpr static sf::Color param_visual_budget_color { sf::Color::Red };
+    constexpr static sf::Color scope_colors[scope_count] {
+        {230, 25, 75}, {60, 180, 75}, {255, 225, 25}, {0, 130, 200}, {245, 130, 48}, {145, 30, 180},
+        {70, 240, 240}, {240, 50, 230}, {210, 245, 60}, {250, 190, 212}, {128, 128, 0},
+        {0, 128, 128}, {220, 190, 255}, {170, 110, 40},
+    };
+
+    /* Any thread; pool workers record while the main thread does */
+    void record(ProfileScope const scope, int64_t const nanoseconds)
+    { m_current[static_cast<size_t>(scope)].fetch_add(nanoseconds, std::memory_order_relaxed); }
+
+    void end_frame();
+
+    [[nodiscard]] float get_average(ProfileScope scope) const; // microseconds, over the history
+    [[nodiscard]] float get_max(ProfileScope scope) const; // microseconds, over the history
+
+    void draw() const;
+    void print() const;
+
+    void set_overlay_enabled(bool const enabled) { m_overlay_enabled = enabled; }
+    [[nodiscard]] bool is_overlay_enabled() const { return m_overlay_enabled; }
+
+private:
+    void rebuild_overlay();
+
+    std::array<std::atomic<int64_t>, scope_count> m_current {}; /* nanoseconds */
+    std::array<std::array<float, scope_count>, param_frame_history> m_history {};
+    size_t m_frame { 0 }; /* next history slot */
+    size_t m_frames_recorded { 0 };
+
+    /* Visual */
+    bool m_overlay_enabled { false };
+    sf::VertexArray m_overlay { sf::PrimitiveType::Triangles };
+};
+
+using Profiler_t = Profiler;
+extern Profiler_t Profiler;
+
+class ProfileTimer
+{
+public:
+    using Clock = Trace_t::Clock;
+
+    explicit ProfileTimer(ProfileScope const scope)
+        : m_scope{scope},
+          m_allocations{AllocationTracker_t::get_totals()},
+          m_start{Clock::now()}
+    { Trace.begin(get_name(), m_start); }
+
+    ~ProfileTimer()
+    {
+        /* i.e. a Universe stepped on a thread of its own; pool workers
+         * run the main universe's tasks (Trace drops their events) */
+        if (!Trace.is_recording_thread() && !ThreadPool_t::is_worker_thread()) return;
+
+        Clock::time_point const stop { Clock::now() };
+        Profiler.record(m_scope, std::chrono::duration_cast<std::chrono::nanoseconds>(stop - m_start).count());
+        Trace.end(get_name(), stop);
+
+        if constexpr (AllocationTracker_t::is_enabled)
+            AllocationTracker.record(m_scope, AllocationTracker_t::get_totals() - m_allocations);
+    }
+
+    ProfileTimer(ProfileTimer const&) = delete;
+    ProfileTimer& operator=(ProfileTimer const&) = delete;
+
+private:
+    [[nodiscard]] char const* get_name() const
+    { return profile_scope_names[static_cast<size_t>(m_scope)]; }
+
+    ProfileScope m_scope;
+    AllocationCounts m_allocations; /* totals at construction */
+    Clock::time_point m_start;
+};
+
+/* Scopes also attribute allocations (see AllocationTracker) */
+#if defined(ORBIT_PROFILER) || defined(ORBIT_TRACK_ALLOCATIONS)
+#define ORBIT_PROFILE_SCOPE(scope) \
+    ProfileTimer const ORBIT_PROFILE_CONCAT(profile_timer_, __LINE__) { ProfileScope::scope }
+#else
+#define ORBIT_PROFILE_SCOPE(scope) ((void)0)
+#endif
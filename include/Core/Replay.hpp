@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <SFML/Window/Keyboard.hpp>
+#include "Core/Level.hpp"
+#include "Math/Vector2.hpp"
+
+/* Everything random in a session derives from these */
+struct ReplaySeeds
+{
+    uint32_t level { 0 };
+    uint32_t player { 0 };
+    uint32_t particles { 0 };
+};
+
+enum class ReplayInputType : uint8_t
+{
+    KeyPressed,
+    MouseClick,
+    MouseSeek, /* Camera seek; stored in world coordinates */
+};
+
+struct ReplayInput
+{
+    uint32_t tick { 0 };
+    ReplayInputType type { ReplayInputType::KeyPressed };
+    sf::Keyboard::Key key { sf::Keyboard::Key::Unknown };
+    sf::Vector2f position;
+};
+
+/* Records a session's seeds & tick-stamped input
+ * stream into a compact binary file, and plays it back.
+ *
+ * File layout (little endian):
+ *   u32 magic, u16 version, u32 tick rate, u32 final tick, 3x u32 seeds,
+ *   u32 planet count, f32 extent scaling factor, f32 planet padding, f32 moon chance,
+ *   then per input: LEB128 tick delta, u8 type, [u8 key | 2x f32 position]
+ */
+class Replay
+{
+public:
+    Replay() = default;
+
+    constexpr static uint32_t param_file_magic { 0x5242524f }; // "ORBR"
+    constexpr static uint16_t param_file_version { 5 };
+    /* Older files were recorded with std::mt19937 (< 3, see Random)
+     * or with nearest planet ties going to the last index (< 5, see Vector2Batch) */
+    constexpr static uint16_t param_min_file_version { 5 };
+
+    /* Recording */
+    void start_recording(
+        std::filesystem::path const& path, ReplaySeeds const& seeds,
+        LevelConfig const& level_config, uint32_t tick_rate
+    );
+    void record(ReplayInput const& input);
+    bool stop_recording(uint32_t final_tick);
+
+    /* Playback */
+    bool load(std::filesystem::path const& path);
+
+    /* Pops the next input recorded for `tick`, if any;
+     * ticks must be polled in increasing order */
+    bool next(uint32_t tick, ReplayInput& input);
+
+    [[nodiscard]] bool is_recording() const { return m_recording; }
+    [[nodiscard]] bool is_playing() const { return m_playing; }
+    [[nodiscard]] bool is_finished(uint32_t const tick) const { return m_playing && tick >= m_final_tick; }
+
+    [[nodiscard]] ReplaySeeds const& get_seeds() const { return m_seeds; }
+    [[nodiscard]] LevelConfig const& get_level_config() const { return m_level_config; }
+    [[nodiscard]] uint32_t get_tick_rate() const { return m_tick_rate; }
+    [[nodiscard]] uint32_t get_final_tick() const { return m_final_tick; }
+
+private:
+    bool m_recording { false };
+    bool m_playing { false };
+
+    std::filesystem::path m_path;
+    ReplaySeeds m_seeds;
+    LevelConfig m_level_config;
+    uint32_t m_tick_rate { 0 };
+    uint32_t m_final_tick { 0 };
+
+    std::vector<ReplayInput> m_inputs;
+    size_t m_cursor { 0 };
+};
+
+using Replay_t = Replay;
+extern Replay_t Replay;
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Entity/Player.hpp"
+#include "Graphics/Particles.hpp"
+
+/* Fixed part of a snapshot; followed in the same slot by
+ *   float planet_mass[planet_count]
+ *   uint8_t orbit_on_bits[(planet_count + 7) / 8]
+ *   ParticleSnapshot particles[particle_count]
+ */
+struct SnapshotHeader
+{
+    PlayerSnapshot player;
+    sf::Vector2i origin_cell; /* positions are relative to it; see WorldOrigin */
+    uint32_t motion_tick; /* moon positions follow from it; see Level::set_motion_tick */
+    uint32_t previous_planet;
+    uint32_t particle_count;
+};
+
+/* Captures the mutable simulation state every tick into
+ * a ring buffer of fixed size slots (one allocation, up front)
+ * and steps backwards through it on demand.
+ *
+ * NOTE: RNG engines are not part of a snapshot;
+ * respawns after a rewind may differ from the original run.
+ */
+class Universe;
+
+class Rewind
+{
+public:
+    explicit Rewind(Universe& universe) : m_universe{universe} {}
+
+    constexpr static float param_capacity_seconds { 5.0f };
+    constexpr static uint32_t param_max_particles { ParticleEmitter::param_max_particles };
+
+    /* Sizes the ring buffer for the current level; drops any snapshots */
+    void init();
+
+    void capture();
+    bool step_back(); /* false => nothing left to rewind */
+
+    void start() { m_rewinding = true; }
+    void stop() { m_rewinding = false; }
+    [[nodiscard]] bool is_rewinding() const { return m_rewinding; }
+
+    [[nodiscard]] size_t get_count() const { return m_count; }
+    [[nodiscard]] size_t get_capacity() const { return m_capacity; }
+    [[nodiscard]] size_t get_slot_size() const { return m_stride; }
+    [[nodiscard]] size_t get_memory_usage() const { return m_buffer.size(); }
+    [[nodiscard]] float get_last_restore_us() const { return m_last_restore_us; }
+
+private:
+    [[nodiscard]] std::byte* get_slot(size_t index);
+
+    Universe& m_universe;
+    std::vector<std::byte> m_buffer;
+    size_t m_stride { 0 };
+    size_t m_capacity { 0 };
+    size_t m_head { 0 }; /* next slot to write */
+    size_t m_count { 0 };
+
+    /* Slot layout (offsets from the start of a slot) */
+    size_t m_planet_count { 0 };
+    size_t m_mass_offset { 0 };
+    size_t m_orbit_bits_offset { 0 };
+    size_t m_particles_offset { 0 };
+
+    bool m_rewinding { false };
+    float m_last_restore_us { 0.0f };
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Entity/Planet.hpp"
+#include "Math/Random.hpp"
+#include "Math/Vector2.hpp"
+
+/* Everything needed to advance a ship
+ * (player look-alike) by one tick, without
+ * going through the Navigation/Assist/Player managers.
+ *
+ * Ships treat every orbit as ON, except the one they last
+ * released from; Assist's planet mass adjustments are
+ * kept per ship (target_mass) instead of being written to the planet.
+ */
+struct ShipState
+{
+    constexpr static uint32_t npos { UINT32_MAX };
+
+    sf::Vector2f position;
+    sf::Vector2f previous_position;
+
+    /* Navigation context (planet indices into Level) */
+    uint32_t target { npos };
+    uint32_t previous { npos };
+    uint32_t excluded { npos };
+    float target_mass { 0.0f };
+
+    bool stable { false };
+};
+
+struct PlanetArrays;
+
+enum class ShipEvent
+{
+    None,
+    Captured, /* Became stable around its target this tick */
+    Collided, /* Hit a planet; state was NOT advanced */
+    Lost, /* No ON orbit to be pulled by */
+};
+
+class Simulation
+{
+public:
+    Simulation() = delete;
+
+    /* Applies the same rules, in the same order,
+     * as one Universe::update() tick does for the player:
+     * Navigation -> Assist -> Orbit (gravity) -> Player (clamp + Verlet).
+     * arrays: the same planets, for the batched scans (see Level::get_planet_arrays()) */
+    static ShipEvent step(ShipState& ship, float dt, std::vector<Planet> const& planets, PlanetArrays const& arrays);
+
+    /* Places the ship on a planet's orbit with
+     * the target tangential velocity; same as Player::reset() */
+    static void place_on_orbit(ShipState& ship, uint32_t planet_idx, float dt,
+                               std::vector<Planet> const& planets, Xoshiro128& random);
+
+    /* Same as Navigation::release_player_from_orbit() */
+    static void release(ShipState& ship) { ship.excluded = ship.target; }
+
+    /* The motion shared by step(), Prediction and the player itself:
+     * Orbit::update()'s gravity, Player::update()'s drift clamp & Verlet integration */
+    [[nodiscard]] static sf::Vector2f get_gravity(sf::Vector2f const& position, sf::Vector2f const& focus, float mass);
+    static void integrate(sf::Vector2f& position, sf::Vector2f& previous_position, sf::Vector2f const& acceleration, float dt);
+
+    /* Gravity towards focus, drift clamp if far_outside, then integration */
+    static void advance(
+        sf::Vector2f& position, sf::Vector2f& previous_position,
+        sf::Vector2f const& focus, float mass, bool far_outside, float dt
+    );
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Math/Vector2.hpp"
+
+/* Uniform grid over points (planet centres); each cell is an intrusive
+ * list, so that a point that moves is only relinked when it crosses
+ * into another cell: refitting costs O(moved points) and never allocates.
+ *
+ * Points must stay within the bounds given to build(); outside of them
+ * they are clamped into the border cells and nearest() may miss them.
+ * Queries report whole cells; callers do the exact test. */
+class SpatialIndex
+{
+public:
+    constexpr static uint32_t npos { Vector2Nearest::npos };
+
+    /* Cells of cell_size covering [min, max] */
+    void build(Vector2ConstSpan points, sf::Vector2f const& min, sf::Vector2f const& max, float cell_size);
+    void clear();
+
+    /* Point idx is now at `position` */
+    void move(uint32_t idx, sf::Vector2f const& position);
+
+    void rebase(sf::Vector2f const& shift) { m_min -= shift; } /* see WorldOrigin */
+
+    /* Same result as Vector2Batch::nearest() over `points` (the span the index tracks) */
+    [[nodiscard]] Vector2Nearest nearest(
+        Vector2ConstSpan points, sf::Vector2f const& from,
+        uint8_t const* mask = nullptr, uint32_t exclude = npos
+    ) const;
+
+    /* fn(idx) for every point in a cell overlapping [min, max];
+     * stops at (and returns true on) the first fn that returns true */
+    template <typename Fn>
+    bool any_in(sf::Vector2f const& min, sf::Vector2f const& max, Fn&& fn) const
+    {
+        if (m_head.empty()) return false;
+
+        sf::Vector2i const first { get_cell(min) };
+        sf::Vector2i const last { get_cell(max) };
+
+        for (int32_t y = first.y; y <= last.y; ++y)
+        for (int32_t x = first.x; x <= last.x; ++x)
+        {
+            for (uint32_t idx = m_head[get_cell_index({ x, y })]; idx != npos; idx = m_next[idx])
+                if (fn(idx)) return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] sf::Vector2i get_size() const { return { m_columns, m_rows }; } /* In cells */
+    [[nodiscard]] uint64_t get_relink_count() const { return m_relink_count; }
+
+private:
+    [[nodiscard]] sf::Vector2i get_cell(sf::Vector2f const& position) const
+    {
+        /* Clamped before the cast; a point far outside must not overflow it */
+        return {
+            static_cast<int32_t>(std::clamp((position.x - m_min.x) / m_cell_size, 0.0f, static_cast<float>(m_columns - 1))),
+            static_cast<int32_t>(std::clamp((position.y - m_min.y) / m_cell_size, 0.0f, static_cast<float>(m_rows - 1)))
+        };
+    }
+    [[nodiscard]] uint32_t get_cell_index(sf::Vector2i const& cell) const
+    { return static_cast<uint32_t>(cell.y * m_columns + cell.x); }
+
+    void link(uint32_t idx, uint32_t cell);
+    void unlink(uint32_t idx);
+
+    sf::Vector2f m_min;
+    float m_cell_size { 1.0f };
+    int32_t m_columns { 0 };
+    int32_t m_rows { 0 };
+
+    std::vector<uint32_t> m_head; /* Per cell; first point or npos */
+    std::vector<uint32_t> m_next; /* Per point */
+    std::vector<uint32_t> m_prev; /* Per point; npos => head of its cell */
+    std::vector<uint32_t> m_cell; /* Per point */
+
+    uint64_t m_relink_count { 0 };
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
+
+/* Startup timeline; every phase is timed from process start
+ * (this manager is constructed before the window opens).
+ *
+ *   Main -> LoadingView -> Level -> Neighborhood -> FirstFrame
+ *
+ * The level is placed on a worker thread while the loading view is up;
+ * gameplay starts once the planets in the initial view have their drawables,
+ * everything else gets one when it first comes into view (see Level::update_drawables).
+ */
+enum class StartupPhase : uint8_t
+{
+    Main, /* Static initialization done; window is open */
+    LoadingView, /* First loading view frame on screen */
+    Level, /* Planets placed (worker thread) */
+    Neighborhood, /* Drawables in the initial view built; gameplay starts */
+    FirstFrame, /* First gameplay frame on screen */
+    Count,
+};
+
+class Startup
+{
+public:
+    Startup() { m_ms.fill(-1.0f); }
+
+    /* Only the first call per phase counts */
+    void mark(StartupPhase phase);
+
+    [[nodiscard]] bool has_reached(StartupPhase const phase) const { return get_ms(phase) >= 0.0f; }
+
+    /* Since process start; negative if not reached (yet) */
+    [[nodiscard]] float get_ms(StartupPhase const phase) const { return m_ms[static_cast<size_t>(phase)]; }
+    [[nodiscard]] float get_time_to_first_frame_ms() const { return get_ms(StartupPhase::FirstFrame); }
+
+    void print() const;
+
+private:
+    sf::Clock m_clock;
+    std::array<float, static_cast<size_t>(StartupPhase::Count)> m_ms;
+};
+
+using Startup_t = Startup;
+extern Startup_t Startup;
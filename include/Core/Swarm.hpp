@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <random>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Core/Simulation.hpp"
+#include "Entity/Planet.hpp"
+#include "Entity/Player.hpp"
+#include "Graphics/World.hpp"
+#include "Math/Random.hpp"
+#include "Math/Vector2.hpp"
+
+/* Autonomous bot ships; used to load-test
+ * the core simulation (navigation, assist, gravity, collision).
+ *
+ * Bots do not go through Navigation/Assist/Player since
+ * those are bound to the one player owned by the Universe;
+ * instead each bot is a ShipState advanced by Simulation::step(),
+ * with state stored contiguously (one array per field).
+ */
+struct SwarmBots
+{
+    std::vector<sf::Vector2f> position;
+    std::vector<sf::Vector2f> previous_position;
+
+    /* Per bot navigation context; see ShipState */
+    std::vector<uint32_t> target;
+    std::vector<uint32_t> previous;
+    std::vector<uint32_t> excluded;
+    std::vector<float> target_mass;
+    std::vector<uint8_t> stable;
+
+    /* Release policy */
+    std::vector<float> stable_time;
+    std::vector<float> release_time;
+
+    std::vector<Xoshiro128> random; /* One stream per bot; see Swarm::spawn() */
+
+    [[nodiscard]] size_t size() const { return position.size(); }
+
+    void resize(size_t count);
+
+    [[nodiscard]] ShipState load(size_t idx) const;
+    void store(size_t idx, ShipState const& ship);
+};
+
+class Universe;
+
+class Swarm
+{
+public:
+    explicit Swarm(Universe& universe) : m_universe{universe} {}
+
+    /* Bot Parameters */
+    ufd const param_bot_release_time_dist { 1.0f, 4.0f }; // seconds spent stable before releasing
+    constexpr static uint32_t param_bot_seed { 0x0b175eed };
+
+    /* Load Test Parameters */
+    constexpr static uint32_t param_sweep_bot_counts[] { 1000, 2000, 4000, 8000, 16000 };
+    constexpr static uint32_t param_sweep_ticks_per_step { 240 };
+
+    /* Visual Parameters */
+    constexpr static float param_visual_bot_size { 12.0f };
+    constexpr static sf::Color param_visual_bot_color { Player::param_visual_thruster_color };
+
+    void draw() const;
+    void update();
+
+    void spawn(uint32_t count);
+    void clear();
+    void rebase(sf::Vector2f const& shift); /* see WorldOrigin */
+
+    /* Steps through param_sweep_bot_counts, reporting
+     * simulation ticks per second for each bot count */
+    void start_sweep();
+    void stop_sweep();
+
+    [[nodiscard]] bool is_active() const { return m_bots.size() > 0; }
+    [[nodiscard]] bool is_sweeping() const { return m_sweep_step < std::size(param_sweep_bot_counts); }
+    [[nodiscard]] SwarmBots const& get_bots() const { return m_bots; }
+
+private:
+    void update_bot(size_t idx, float dt);
+    void respawn_bot(size_t idx, uint32_t planet_idx);
+    void update_sweep(float tick_seconds);
+    void rebuild_vertices(size_t begin, size_t end);
+
+    Universe& m_universe;
+    SwarmBots m_bots;
+
+    /* Statistics */
+    std::atomic<uint32_t> m_releases { 0 };
+    std::atomic<uint32_t> m_captures { 0 };
+    std::atomic<uint32_t> m_explosions { 0 };
+
+    /* Load Test */
+    size_t m_sweep_step { std::size(param_sweep_bot_counts) };
+    uint32_t m_sweep_ticks { 0 };
+    double m_sweep_seconds { 0.0 };
+
+    /* Visual */
+    sf::VertexArray m_vertices { sf::PrimitiveType::Triangles };
+};
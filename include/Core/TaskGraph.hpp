@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+#include "Core/ThreadPool.hpp"
+
+enum class TaskAffinity : uint8_t
+{
+    Any, /* any pool thread, or the caller */
+    Caller, /* only the thread that calls run(); e.g. the main thread */
+};
+
+/* Fork/join graph of tasks; built once, run every frame.
+ * A task starts once every task it depends on has finished;
+ * tasks with no path between them run concurrently on the pool.
+ * Dependencies must have been added before their dependents,
+ * so the graph is acyclic and insertion order is a valid order.
+ *
+ * Running does not allocate; the tasks' own work aside */
+class TaskGraph
+{
+public:
+    using TaskId = uint32_t;
+
+    TaskGraph() = default;
+    TaskGraph(TaskGraph const&) = delete;
+    TaskGraph& operator=(TaskGraph const&) = delete;
+
+    TaskId add(
+        std::function<void()> fn,
+        std::initializer_list<TaskId> depends_on = {},
+        TaskAffinity affinity = TaskAffinity::Any
+    );
+
+    /* Every task once; returns when all have finished. The caller
+     * runs its own tasks and helps with the pool's meanwhile; as in
+     * ThreadPool::wait(), whatever is queued, so a long job pushed by
+     * someone else can end up between the caller's tasks.
+     * No pool => inline, in insertion order (deterministic).
+     * Not reentrant: one run() at a time per graph, and never from
+     * one of its own tasks (the per run state is the graph's; asserted) */
+    void run(ThreadPool_t* pool);
+
+    [[nodiscard]] size_t get_task_count() const { return m_tasks.size(); }
+
+private:
+    struct Task
+    {
+        std::function<void()> fn;
+        TaskAffinity affinity;
+        std::vector<TaskId> successors;
+        uint32_t dependency_count { 0 };
+        std::atomic<uint32_t> pending { 0 }; /* dependencies left this run */
+
+        Task(std::function<void()> task_fn, TaskAffinity const task_affinity)
+            : fn{std::move(task_fn)}, affinity{task_affinity} {}
+    };
+
+    void schedule(TaskId id);
+    void run_task(TaskId id);
+
+    std::deque<Task> m_tasks; /* stable; tasks hold an atomic */
+
+    /* Per run */
+    std::atomic<bool> m_running { false };
+    ThreadPool_t* m_pool { nullptr };
+    JobLatch m_remaining;
+    std::mutex m_caller_mutex;
+    std::vector<TaskId> m_caller_ready; /* capacity for every task; never grows during a run */
+    size_t m_caller_next { 0 };
+};
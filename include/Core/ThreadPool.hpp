@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/* Counts outstanding jobs; whoever waits on it helps run them */
+class JobLatch
+{
+public:
+    explicit JobLatch(uint32_t const count = 0) : m_pending{count} {}
+
+    void add(uint32_t const count) { m_pending.fetch_add(count, std::memory_order_relaxed); }
+    void count_down() { m_pending.fetch_sub(1, std::memory_order_acq_rel); }
+    [[nodiscard]] bool is_done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::atomic<uint32_t> m_pending;
+};
+
+/* A range of a parallel_for, or a task graph node; trivially
+ * copyable so that queuing one never allocates */
+struct Job
+{
+    void (*invoke)(void* context, size_t begin, size_t end) { nullptr };
+    void* context { nullptr };
+    size_t begin { 0 };
+    size_t end { 0 };
+    JobLatch* latch { nullptr }; /* counted down once the job has run */
+};
+
+/* Fixed capacity double ended queue; the owner pushes & pops
+ * at the back (newest first, still warm in its cache),
+ * thieves take from the front (oldest, usually the largest work) */
+class JobDeque
+{
+public:
+    constexpr static size_t param_capacity { 1024 };
+
+    [[nodiscard]] bool push(Job const& job); /* false if full */
+    [[nodiscard]] bool pop(Job& job);
+    [[nodiscard]] bool steal(Job& job);
+
+private:
+    std::mutex m_mutex; /* held for a few instructions; thieves rarely contend */
+    Job m_jobs[param_capacity];
+    size_t m_head { 0 }; /* front; monotonic, wrapped on access */
+    size_t m_tail { 0 }; /* back */
+};
+
+/* Work-stealing pool; each worker runs its own deque and steals
+ * from the others (and from the injection deque that threads outside
+ * the pool push to) when it runs dry. Waiting is never idle: a thread
+ * that joins on a latch runs queued jobs until the latch opens, so
+ * jobs may fork & join further work (parallel_for within a job).
+ *
+ * Nothing allocates once the workers are up; if a deque is full
+ * the job just runs inline. The main thread keeps the window,
+ * only plain simulation work should be handed to the pool. */
+class ThreadPool
+{
+public:
+    /* worker_count = 0 => one worker per hardware thread,
+     * minus the calling thread (which also takes part in parallel_for) */
+    explicit ThreadPool(uint32_t worker_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /* Parameters */
+    constexpr static size_t param_chunks_per_thread { 4 }; /* > 1, so that uneven chunks are balanced by stealing */
+    constexpr static uint32_t param_idle_spins { 64 }; /* failed steal attempts before a worker sleeps */
+
+    /* Queued on the calling worker's deque (or the injection deque);
+     * job.latch, if any, must have been counted up for it beforehand */
+    void push(Job const& job);
+
+    /* Runs queued jobs until the latch opens. Any queued job, not only
+     * the latch's: a long unrelated one (e.g. another task graph node)
+     * taken meanwhile delays the return by however long it runs */
+    void wait(JobLatch const& latch);
+
+    /* One queued job, if any; false if every deque is empty */
+    bool try_run_one();
+
+    /* Splits [0, count) into contiguous chunks, a few per thread;
+     * fn(begin, end) is called concurrently. Blocks until every chunk
+     * has been processed; the caller runs chunks meanwhile */
+    template <typename Fn>
+    void parallel_for(size_t const count, Fn&& fn)
+    {
+        using Callable = std::remove_reference_t<Fn>;
+        parallel_for_impl(
+            count,
+            [](void* const context, size_t const begin, size_t const end)
+            { (*static_cast<Callable*>(context))(begin, end); },
+            const_cast<void*>(static_cast<void const*>(&fn))
+        );
+    }
+
+    [[nodiscard]] uint32_t get_worker_count() const { return static_cast<uint32_t>(m_workers.size()); }
+    [[nodiscard]] uint32_t get_thread_count() const { return get_worker_count() + 1; } // + caller
+
+    /* Any pool's worker; as opposed to the main thread & other plain threads */
+    [[nodiscard]] static bool is_worker_thread();
+
+private:
+    void parallel_for_impl(size_t count, void (*invoke)(void*, size_t, size_t), void* context);
+
+    void worker_loop(uint32_t index);
+    [[nodiscard]] bool try_take(Job& job);
+    static void run(Job const& job);
+
+    [[nodiscard]] JobDeque& get_local_deque();
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<JobDeque>> m_deques; /* one per worker, then the injection deque */
+
+    std::atomic<size_t> m_queued { 0 }; /* jobs in any deque */
+    std::atomic<uint32_t> m_sleepers { 0 };
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_condition;
+    std::atomic<bool> m_stopping { false };
+};
+
+using ThreadPool_t = ThreadPool;
+extern ThreadPool_t ThreadPool;
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+/* Frame timeline recorder; writes Chrome trace event JSON
+ * (loads in Perfetto / chrome://tracing).
+ * Events go into a ring buffer allocated once, so a dump always
+ * holds the most recent param_capacity events. Only builds with the
+ * profiler (ORBIT_PROFILER) allocate it; the others record nothing.
+ *
+ * NOTE: Main thread only (the one that constructed it; events from any other
+ * thread are dropped); names must outlive the recorder (string literals)
+ */
+
+enum class TracePhase : char
+{
+    Begin = 'B',
+    End = 'E',
+    Instant = 'i',
+};
+
+struct TraceEvent
+{
+    char const* name;
+    int64_t timestamp_ns; /* since Trace construction */
+    TracePhase phase;
+};
+
+class Trace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Trace();
+
+    /* Parameters */
+    constexpr static size_t param_capacity { 1u << 18 }; // ~20s of profiled frames at 120fps
+    constexpr static auto param_default_path { "orbit-trace.json" };
+
+    void begin(char const* name, Clock::time_point const time = Clock::now())
+    { push({ name, since_epoch(time), TracePhase::Begin }); }
+
+    void end(char const* name, Clock::time_point const time = Clock::now())
+    { push({ name, since_epoch(time), TracePhase::End }); }
+
+    void instant(char const* name)
+    { push({ name, since_epoch(Clock::now()), TracePhase::Instant }); }
+
+    bool dump(std::filesystem::path const& path) const;
+
+    [[nodiscard]] size_t get_count() const { return m_count; }
+    [[nodiscard]] bool is_recording_thread() const { return std::this_thread::get_id() == m_thread; }
+
+private:
+    [[nodiscard]] int64_t since_epoch(Clock::time_point const time) const
+    { return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count(); }
+
+    void push(TraceEvent const& event)
+    {
+        if (m_events.empty() || !is_recording_thread()) return;
+        m_events[m_head] = event;
+        m_head = (m_head + 1) % param_capacity;
+        if (m_count < param_capacity) ++m_count;
+    }
+
+    Clock::time_point m_epoch;
+    std::thread::id m_thread;
+    std::vector<TraceEvent> m_events;
+    size_t m_head { 0 }; /* next slot to write */
+    size_t m_count { 0 };
+};
+
+using Trace_t = Trace;
+extern Trace_t Trace;
+
+/* Phase scopes & gameplay markers; compiled with the profiler (ORBIT_PROFILER) */
+class TraceScope
+{
+public:
+    explicit TraceScope(char const* name) : m_name{name} { Trace.begin(m_name); }
+    ~TraceScope() { Trace.end(m_name); }
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator=(TraceScope const&) = delete;
+
+private:
+    char const* m_name;
+};
+
+#define ORBIT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ORBIT_PROFILE_CONCAT(a, b) ORBIT_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ORBIT_PROFILER
+#define ORBIT_TRACE_SCOPE(name) TraceScope const ORBIT_PROFILE_CONCAT(trace_scope_, __LINE__) { name }
+#define ORBIT_TRACE_INSTANT(name) Trace.instant(name)
+#else
+#define ORBIT_TRACE_SCOPE(name) ((void)0)
+#define ORBIT_TRACE_INSTANT(name) ((void)0)
+#endif
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include "Core/Assist.hpp"
+#include "Core/FrameArena.hpp"
+#include "Core/LaunchSolver.hpp"
+#include "Core/Level.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/Prediction.hpp"
+#include "Core/Replay.hpp"
+#include "Core/Rewind.hpp"
+#include "Core/Swarm.hpp"
+#include "Core/TaskGraph.hpp"
+#include "Core/WorldOrigin.hpp"
+#include "Entity/Player.hpp"
+#include "Graphics/Particles.hpp"
+
+/* One independent simulation: a level, its player and every
+ * manager that acts on them. Subsystems reach each other through
+ * the universe that owns them, never through globals; so several
+ * universes (different seeds, configs) can step concurrently,
+ * one thread each.
+ *
+ * What stays process wide is presentation & instrumentation:
+ * Window, Camera, Capture, Profiler, Trace, Log, ThreadPool.
+ * Profiler records the main thread & pool workers (atomically), Trace only the main thread.
+ *
+ * A tick runs as a task graph; given a pool, the bots step alongside
+ * Navigation, and Prediction alongside the LaunchSolver. The player's
+ * chain always runs on the calling thread. Without one (the default)
+ * every task runs inline, in order.
+ *
+ * NOTE: Not copyable or movable; subsystems keep a reference to it
+ */
+class Universe
+{
+public:
+    explicit Universe(uint32_t tick_rate = param_default_tick_rate);
+
+    Universe(Universe const&) = delete;
+    Universe& operator=(Universe const&) = delete;
+
+    /* Parameters */
+    constexpr static uint32_t param_default_tick_rate { 120 }; // matches Window's default framerate limit
+
+    /* One tick; moons move, then Navigation -> Assist -> Orbit -> Player,
+     * with rewind, bots, prediction and the launch hint around them */
+    void update();
+
+    /* Pool the tick's independent tasks run on; nullptr => all inline */
+    void set_thread_pool(ThreadPool_t* const pool) { m_thread_pool = pool; }
+
+    /* Player & particle randomness; the level takes its seed on generate() */
+    void seed(ReplaySeeds const& seeds);
+
+    /* The simulation steps by 1 / tick rate, however long a tick really takes */
+    void set_tick_rate(uint32_t const tick_rate) { m_tick_rate = tick_rate; }
+    [[nodiscard]] uint32_t get_tick_rate() const { return m_tick_rate; }
+    [[nodiscard]] float get_delta_time() const { return 1.0f / static_cast<float>(m_tick_rate); }
+
+    Level& get_level() { return m_level; }
+    Level const& get_level() const { return m_level; }
+
+    WorldOrigin& get_origin() { return m_origin; }
+    WorldOrigin const& get_origin() const { return m_origin; }
+
+    Navigation& get_navigation() { return m_navigation; }
+    Navigation const& get_navigation() const { return m_navigation; }
+
+    Assist& get_assist() { return m_assist; }
+    Assist const& get_assist() const { return m_assist; }
+
+    Player& get_player() { return m_player; }
+    Player const& get_player() const { return m_player; }
+
+    ParticleEmitter& get_particles() { return m_particles; }
+    ParticleEmitter const& get_particles() const { return m_particles; }
+
+    Prediction& get_prediction() { return m_prediction; }
+    Prediction const& get_prediction() const { return m_prediction; }
+
+    Rewind& get_rewind() { return m_rewind; }
+    Rewind const& get_rewind() const { return m_rewind; }
+
+    Swarm& get_swarm() { return m_swarm; }
+    Swarm const& get_swarm() const { return m_swarm; }
+
+    LaunchSolver& get_launch_solver() { return m_launch_solver; }
+    LaunchSolver const& get_launch_solver() const { return m_launch_solver; }
+
+    FrameArena& get_frame_arena() { return m_frame_arena; }
+    FrameArena const& get_frame_arena() const { return m_frame_arena; }
+
+private:
+    void advance_motion(); /* Moons, and whoever is orbiting one */
+    void build_frame_graph();
+
+    uint32_t m_tick_rate;
+    ThreadPool_t* m_thread_pool { nullptr };
+
+    /* Constructed in this order; the ones
+     * further down may refer to the ones above */
+    FrameArena m_frame_arena;
+    Level m_level;
+    WorldOrigin m_origin;
+    Navigation m_navigation;
+    Assist m_assist;
+    ParticleEmitter m_particles;
+    Player m_player;
+    Prediction m_prediction;
+    Rewind m_rewind;
+    Swarm m_swarm;
+    LaunchSolver m_launch_solver;
+
+    TaskGraph m_frame_graph; /* Refers to the subsystems above */
+};
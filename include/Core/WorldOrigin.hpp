@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+/* Floating origin; every world position (planets, player, particles,
+ * bots, camera, ...) is a float offset from the current origin cell:
+ *
+ *   absolute = get_cell() * param_cell_size + local
+ *
+ * Once the player strays more than a cell from the origin, the origin moves
+ * to the player's cell and everything is shifted back by whole cells; so the
+ * hot path (Verlet integration, Navigation, Collision, rendering) keeps
+ * working with small numbers however large the level is.
+ * The shift itself is exact (whole cells of a power of two), but subtracting
+ * it from a position rounds, as any float subtraction does. For what moves
+ * every tick that is one more rounding among many; planets that hold still
+ * are put back at their absolute place instead (see Level::rebase()), so
+ * they do not drift however often the origin moves. Rewind snapshots keep
+ * the origin cell along with the positions, and restore it first.
+ * Anything outside the universe (i.e. the camera) subscribes to the shift.
+ */
+using RebaseListener = std::function<void(sf::Vector2f const& shift)>;
+
+class Universe;
+
+class WorldOrigin
+{
+public:
+    explicit WorldOrigin(Universe& universe) : m_universe{universe} {}
+
+    /* Parameters */
+    constexpr static float param_cell_size { 4096.0f }; // power of two
+    constexpr static float param_rebase_distance { param_cell_size }; /* Player's distance (per axis) that triggers a rebase */
+
+    /* Rebases around `focus` (local) if it is too far out; once per update, before anything moves */
+    void update(sf::Vector2f const& focus);
+
+    /* Shifts every world position, so that `cell` becomes the origin */
+    void rebase_to(sf::Vector2i const& cell);
+
+    void subscribe(RebaseListener listener) { m_listeners.push_back(std::move(listener)); }
+
+    /* Forgets the current origin without shifting anything; for a freshly generated level */
+    void reset() { m_cell = {}; }
+
+    [[nodiscard]] sf::Vector2i const& get_cell() const { return m_cell; }
+    [[nodiscard]] uint32_t get_rebase_count() const { return m_rebase_count; }
+
+    [[nodiscard]] sf::Vector2<double> to_absolute(sf::Vector2f const& local) const
+    {
+        return {
+            static_cast<double>(m_cell.x) * param_cell_size + local.x,
+            static_cast<double>(m_cell.y) * param_cell_size + local.y,
+        };
+    }
+
+    [[nodiscard]] sf::Vector2f to_local(sf::Vector2<double> const& absolute) const
+    {
+        return {
+            static_cast<float>(absolute.x - static_cast<double>(m_cell.x) * param_cell_size),
+            static_cast<float>(absolute.y - static_cast<double>(m_cell.y) * param_cell_size),
+        };
+    }
+
+private:
+    Universe& m_universe;
+    std::vector<RebaseListener> m_listeners;
+
+    sf::Vector2i m_cell;
+    uint32_t m_rebase_count { 0 };
+};
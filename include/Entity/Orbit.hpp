@@ -19,27 +19,50 @@ public:
     constexpr static float param_visual_ring_highlight_clamp { 0.4f };
     constexpr static float param_visual_ring_highlight_factor { 2.0f };
     constexpr static float param_visual_outer_ring_offset { World::scale_distance(35.0f) };
+    constexpr static float param_visual_ring_outline_thickness { 2.0f };
+
+    using Rings = sf::CircleShape[param_visual_ring_count];
 
     void draw() const;
-    void update();
+    void update(Player& player); /* Pulls the player in */
 
     [[nodiscard]] float get_radius() const { return m_radius; }
     sf::Vector2f const& get_origin() const { return m_owner.position; }
 
-    void turn_on() { m_state = true; init_rings(); }
-    void turn_off() { m_state = false; init_rings(); }
-    void toggle() { m_state = !m_state; init_rings(); }
+    /* The state only shows in the ring fill; the ring geometry is left alone */
+    void turn_on() { set_state_flag(true); update_ring_fill(); }
+    void turn_off() { set_state_flag(false); update_ring_fill(); }
+    void toggle() { set_state_flag(!m_state); update_ring_fill(); }
+    void set_state(bool const state) { if (state != m_state) toggle(); } /* Skips the fill update if unchanged */
+    void clear_highlight() { update_ring_fill(); }
+
+    /* Rings live in a pooled PlanetDrawable while the planet is on screen; see Level::update_drawables() */
+    void attach_rings(Rings& rings) { m_rings = &rings; init_rings(); }
+    void detach_rings() { m_rings = nullptr; }
+    [[nodiscard]] bool has_rings() const { return m_rings != nullptr; }
+
+    /* Drawn extent, from the origin */
+    [[nodiscard]] float get_visual_radius() const
+    { return m_radius + param_visual_outer_ring_offset + param_visual_ring_outline_thickness; }
+    void follow_owner() { if (m_rings) for (auto& ring : *m_rings) ring.setPosition(get_origin()); } /* Owner has moved or been rebased */
 
     [[nodiscard]] bool is_on() const { return m_state; }
 
+    /* Keeps *mirror == is_on(); see Level::get_planet_arrays() */
+    void bind_state_mirror(uint8_t* const mirror) { m_state_mirror = mirror; set_state_flag(m_state); }
+
 private:
+    void set_state_flag(bool const state) { m_state = state; if (m_state_mirror) *m_state_mirror = state; }
+
     bool m_state;
+    uint8_t* m_state_mirror { nullptr };
     float m_radius;
     PlanetInfo const& m_owner;
 
     /* Visual */
-    void init_rings(float highlight_factor = 0.0f);
+    void init_rings(); /* Geometry & fill; once per attach */
+    void update_ring_fill(float highlight_factor = 0.0f);
 
     sf::Color m_color;
-    sf::CircleShape m_rings[param_visual_ring_count];
+    Rings* m_rings { nullptr };
 };
@@ -3,6 +3,7 @@
 #include "Entity/PlanetInfo.hpp"
 #include "Entity/Orbit.hpp"
 #include "Graphics/Color.hpp"
+#include "Graphics/PlanetDrawable.hpp"
 #include "Math/Vector2.hpp"
 
 class Planet
@@ -15,6 +16,15 @@ public:
     );
 
     void draw() const;
+    void rebase(sf::Vector2f const& shift) { set_position(m_info.position - shift); } /* see WorldOrigin */
+
+    /* Shape & rings follow; their geometry stays as is */
+    void set_position(sf::Vector2f const& position);
+
+    /* Shape & orbit rings; only while on screen (see Level::update_drawables) */
+    void attach_drawable(PlanetDrawable& drawable);
+    PlanetDrawable* detach_drawable(); /* nullptr if there was none */
+    [[nodiscard]] bool has_drawable() const { return m_drawable != nullptr; }
 
     sf::Vector2f const& get_position() const { return m_info.position; }
 
@@ -30,7 +40,7 @@ public:
 private:
     void init_shape();
 
-    sf::CircleShape m_shape;
+    PlanetDrawable* m_drawable { nullptr };
     PlanetInfo m_info;
     Orbit m_orbit;
 };
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <SFML/Graphics.hpp>
 #include "Entity/PlanetInfo.hpp"
 #include "Graphics/World.hpp"
+#include "Math/Random.hpp"
 
 using ThrusterArray = std::array<sf::ConvexShape, 4>;
 
@@ -21,14 +23,34 @@ enum class PlayerState
     Exploding,
 };
 
+/* One bit per PlayerState; computed once per tick
+ * by Navigation (see Player::classify), so that
+ * Player::is() is a bit test */
+using PlayerStateMask = uint32_t;
+
+constexpr PlayerStateMask player_state_mask(PlayerState const state)
+{ return 1u << static_cast<uint32_t>(state); }
+
+/* Mutable player state; see Rewind */
+struct PlayerSnapshot
+{
+    sf::Vector2f position;
+    sf::Vector2f previous_position;
+    sf::Vector2f acceleration;
+    bool exploding;
+};
+
+class Universe;
+
 class Player
 {
 public:
-    explicit Player();
+    explicit Player(Universe& universe);
 
     /* Configuration Parameters */
     constexpr static float param_target_orbital_velocity { World::scale_distance(500.0f) };
     constexpr static float param_max_drift_velocity { World::scale_distance(1000.0f) };
+    constexpr static int64_t param_drift_warning_interval_ms { 1000 }; // clamp warnings are rate limited
     constexpr static float param_orbit_error_tolerance { 15.0f }; // +- error within target radius = "in orbit"
     constexpr static float param_orbit_far_distance_factor { 1.5f }; // governs how far away is considered "far outside orbit"
 
@@ -49,8 +71,13 @@ public:
     void explode();
 
     void reset();
+    void seed(uint32_t const seed) { m_random = Random{seed}; } /* Respawn randomness */
     bool is(PlayerState const& state) const;
 
+    /* Every state except Exploding (which is tracked by the player itself),
+     * derived from the player's error & radial velocity relative to the target orbit */
+    [[nodiscard]] static PlayerStateMask classify(float player_error, sf::Vector2f const& player_radial_v);
+
     sf::Vector2f const& get_position() const { return m_position; }
     sf::Vector2f get_velocity() const;
 
@@ -58,12 +85,18 @@ public:
     float get_distance(sf::Vector2f const& from_pos) const;
     float get_distance_squared(sf::Vector2f const& from_pos) const;
 
-    sf::Vector2f get_radial_velocity_vector() const;
+    sf::Vector2f get_radial_velocity_vector() const; /* Relative to the context's target orbit */
     sf::Vector2f get_tangential_velocity_vector() const;
+    sf::Vector2f get_radial_velocity_vector(sf::Vector2f const& origin) const;
+    sf::Vector2f get_tangential_velocity_vector(sf::Vector2f const& origin) const;
 
     void invert_velocity();
     void set_velocity(sf::Vector2f const& new_velocity); /* NOTE: WILL NULL THE ACCELERATION */
     void set_position(sf::Vector2f const& position); /* NOTE: WILL NULL THE VELOCITY */
+    void rebase(sf::Vector2f const& shift); /* Keeps the velocity; see WorldOrigin */
+
+    [[nodiscard]] PlayerSnapshot save() const;
+    void restore(PlayerSnapshot const& snapshot);
 
     sf::Shape const& get_core() const { return m_core; }
     ThrusterArray const& get_thrusters() const { return m_thrusters; }
@@ -71,6 +104,7 @@ public:
 private:
     void init_shapes();
 
+    Universe& m_universe;
     bool m_exploding { false };
 
     sf::Vector2f m_position;
@@ -79,4 +113,6 @@ private:
 
     sf::CircleShape m_core;
     ThrusterArray m_thrusters;
+
+    Random m_random;
 };
@@ -24,7 +24,7 @@ public:
         sf::Vector2f const current_pos { view.getCenter() };
         sf::Vector2f const new_pos {
                 current_pos +
-                (m_target - current_pos)
+                (get_target() - current_pos)
                 * (1.0f - m_follow_smoothing_power)
                 * 10.0f * Window.get_delta_time()
         };
@@ -32,12 +32,27 @@ public:
         view.setCenter(new_pos);
     }
 
+    /* Fixed target (seek mode); only while not locked */
     void set_target(sf::Vector2f const& target) { if (!m_locked) m_target = target; }
-    [[nodiscard]] sf::Vector2f const& get_target() const { return m_target; }
+
+    /* Tracked target; followed whenever the camera is not locked.
+     * Keeps a reference, so a moving target only has to be set once */
+    void follow(sf::Vector2f const& target) { m_follow = &target; }
+
+    [[nodiscard]] sf::Vector2f const& get_target() const
+    { return (m_locked || !m_follow) ? m_target : *m_follow; }
 
     void set_follow_smoothing_power(float const power) { if (!m_locked) m_follow_smoothing_power = power; }
     [[nodiscard]] float get_follow_smoothing_power() const { return m_follow_smoothing_power; }
 
+    /* see WorldOrigin; followed targets move by themselves */
+    void rebase(sf::Vector2f const& shift)
+    {
+        auto& view { Window.get_view() };
+        view.setCenter(view.getCenter() - shift);
+        m_target -= shift;
+    }
+
     void unlock() { m_locked = false; }
     void lock() { m_locked = true; m_lock_timer.restart(); }
 
@@ -47,6 +62,7 @@ private:
     float m_follow_smoothing_power { param_player_follow_smoothing_power };
     bool m_locked { false };
     sf::Vector2f m_target;
+    sf::Vector2f const* m_follow { nullptr };
     sf::Clock m_lock_timer;
 };
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics/RenderTexture.hpp>
+
+enum class CaptureFormat : uint8_t
+{
+    Png,
+    Raw, /* RGBA8, rows top to bottom; size in the file name */
+};
+
+/* Frame capture (screenshots, clips, golden images for render tests):
+ * a captured frame is rendered into an offscreen texture instead of the window,
+ * read back, and handed to a background encoder thread that writes the file.
+ *
+ * Frames go through a bounded queue of reusable pixel buffers; when every buffer
+ * is still waiting for the encoder the frame is dropped, so capturing never
+ * waits on the encoder. The readback itself is synchronous, straight into a free
+ * buffer (sf::Texture::copyToImage() would allocate an image every frame);
+ * the encoder puts the rows the right way up.
+ *
+ * Works without a window being shown (--headless renders captured frames only);
+ * on a box without a GPU, run under Xvfb with Mesa's software renderer
+ * (LIBGL_ALWAYS_SOFTWARE=1); multisampling is dropped if the driver lacks it.
+ */
+class Capture
+{
+public:
+    Capture() = default;
+    ~Capture();
+
+    Capture(Capture const&) = delete;
+    Capture& operator=(Capture const&) = delete;
+
+    /* Parameters */
+    constexpr static size_t param_queue_capacity { 4 }; /* Pixel buffers */
+    constexpr static float param_resolution_scale { 0.5f }; /* Of the window's internal resolution */
+    constexpr static uint32_t param_antialiasing_level { 4 };
+    constexpr static auto param_default_directory { "captures" };
+
+    /* Every nth frame, from the next one on */
+    void start(std::filesystem::path const& directory, uint32_t every_nth_frame = 1, CaptureFormat format = CaptureFormat::Png);
+    void stop() { m_every_nth_frame = 0; }
+    [[nodiscard]] bool is_recording() const { return m_every_nth_frame > 0; }
+
+    /* Just the next frame */
+    void request_screenshot(std::filesystem::path const& directory = param_default_directory);
+
+    [[nodiscard]] bool wants(uint32_t tick) const;
+
+    /* Around Game::render(); begin_frame() redirects the window (returns false if
+     * `tick` is not captured), end_frame() queues the frame & shows it in the window if `present` */
+    bool begin_frame(uint32_t tick);
+    void end_frame(bool present);
+
+    /* Blocks until every queued frame is written; e.g. before exit */
+    void flush();
+
+    [[nodiscard]] uint64_t get_written_count() const;
+    [[nodiscard]] uint64_t get_dropped_count() const { return m_dropped_count; }
+    void print() const;
+
+private:
+    struct Frame
+    {
+        std::vector<uint8_t> pixels; /* Reused; RGBA8, rows bottom to top (as OpenGL reads them) */
+        sf::Vector2u size;
+        std::filesystem::path path;
+        CaptureFormat format { CaptureFormat::Png };
+    };
+
+    bool init_texture();
+    void encoder_loop();
+    static bool write(Frame const& frame);
+
+    std::optional<sf::RenderTexture> m_texture;
+    bool m_texture_failed { false };
+
+    std::filesystem::path m_directory;
+    CaptureFormat m_format { CaptureFormat::Png };
+    uint32_t m_every_nth_frame { 0 };
+    uint32_t m_start_tick { 0 };
+    bool m_screenshot_requested { false };
+    std::filesystem::path m_screenshot_directory;
+
+    /* Frame being captured */
+    uint32_t m_tick { 0 };
+    CaptureFormat m_frame_format { CaptureFormat::Png };
+    std::filesystem::path m_frame_directory;
+    bool m_frame_is_screenshot { false };
+    uint32_t m_screenshot_count { 0 }; /* Name suffix; the tick alone repeats (e.g. while paused) */
+
+    /* Encoder; m_frames never reallocates, m_free & m_queue hold indices */
+    Frame m_frames[param_queue_capacity];
+    std::vector<size_t> m_free;
+    std::vector<size_t> m_queue; /* FIFO; at most param_queue_capacity */
+    size_t m_encoding_count { 0 };
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition; /* Encoder wakeup */
+    std::condition_variable m_idle; /* flush() wakeup */
+    std::thread m_encoder;
+    bool m_stopping { false };
+
+    uint64_t m_captured_count { 0 };
+    uint64_t m_dropped_count { 0 };
+    uint64_t m_written_count { 0 }; /* Guarded by m_mutex */
+    uint64_t m_failed_count { 0 }; /* Guarded by m_mutex */
+};
+
+using Capture_t = Capture;
+extern Capture_t Capture;
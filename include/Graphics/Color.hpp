@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 #include <SFML/Graphics/Color.hpp>
@@ -116,4 +119,48 @@ private:
             static_cast<uint8_t>(a * 255)
         );
     };
-};
\ No newline at end of file
+};
+
+/* Hue -> color lookup table for one fixed (whiteness, blackness) /
+ * (saturation, lightness|value) pair; built at compile time:
+ *
+ *   constexpr static ColorPalette palette { ColorPalette::make<Color::HWB>(65.0, 0.0) };
+ *   palette.get(hue); // degrees, wraps around
+ *
+ * Hue is quantized to param_hue_steps per turn (~0.35 degrees) */
+class ColorPalette
+{
+public:
+    constexpr static uint32_t param_hue_steps { 1024 }; // power of two
+
+    template <Color::Format F>
+    [[nodiscard]] constexpr static ColorPalette make(double const x, double const y, double const a = 100.0)
+    {
+        ColorPalette palette {};
+        for (uint32_t idx = 0; idx < param_hue_steps; ++idx)
+        {
+            double const hue { 360.0 * idx / param_hue_steps };
+            if constexpr (F == Color::HWB) palette.m_colors[idx] = Color::hwb(hue, x, y, a);
+            else if constexpr (F == Color::HSL) palette.m_colors[idx] = Color::hsl(hue, x, y, a);
+            else palette.m_colors[idx] = Color::hsv(hue, x, y, a);
+        }
+        return palette;
+    }
+
+    [[nodiscard]] sf::Color get(float const hue) const
+    {
+        /* Nearest step (halves round up, negative hues too), then wrapped into [0, param_hue_steps) */
+        auto const step { static_cast<int64_t>(std::floor(hue * (param_hue_steps / 360.0f) + 0.5f)) };
+        int64_t const wrapped { step % int64_t{param_hue_steps} };
+        return m_colors[static_cast<size_t>(wrapped < 0 ? wrapped + param_hue_steps : wrapped)];
+    }
+
+    /* Batch conversion; out[idx] = get(hues[idx]) */
+    void fill(sf::Color* const out, float const* const hues, size_t const count) const
+    {
+        for (size_t idx = 0; idx < count; ++idx) out[idx] = get(hues[idx]);
+    }
+
+private:
+    std::array<sf::Color, param_hue_steps> m_colors {};
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+/* Helpers for debug overlays (see Window::draw_overlay);
+ * drawn as sf::PrimitiveType::Triangles vertex arrays */
+class Overlay
+{
+public:
+    Overlay() = delete;
+
+    static void append_rect(
+        sf::VertexArray& vertices, sf::Vector2f const& position,
+        sf::Vector2f const& size, sf::Color const& color
+    )
+    {
+        sf::Vector2f const top_right { position.x + size.x, position.y };
+        sf::Vector2f const bottom_left { position.x, position.y + size.y };
+        sf::Vector2f const bottom_right { position + size };
+
+        vertices.append({position, color});
+        vertices.append({top_right, color});
+        vertices.append({bottom_left, color});
+        vertices.append({top_right, color});
+        vertices.append({bottom_right, color});
+        vertices.append({bottom_left, color});
+    }
+};
@@ -3,6 +3,7 @@
 #include <utility>
 #include <vector>
 #include <SFML/Graphics.hpp>
+#include "Graphics/Color.hpp"
 #include "Graphics/World.hpp"
 #include "Math/Random.hpp"
 
@@ -13,16 +14,34 @@ struct Particle
     float lifetime { 0.0f };
 };
 
+/* POD copy of a Particle; see Rewind */
+struct ParticleSnapshot
+{
+    sf::Vector2f velocity;
+    sf::Vector2f position;
+    sf::Vector2f size;
+    sf::Color color;
+    float lifetime;
+};
+
+class Universe;
+
 class ParticleEmitter
 {
 public:
-    ParticleEmitter() = default;
+    /* Every particle is built once, here; emit() & restore() only overwrite them */
+    explicit ParticleEmitter(Universe& universe) : m_universe{universe}, m_particles(param_max_particles) {}
+
+    constexpr static uint32_t param_max_particles { 100 };
 
     /* Visual Parameters */
     ufd const param_visual_particle_radius_dist {2.0f, 6.0f};
     ufd const param_visual_particle_color_hue_dist {0.0f, 359.0f};
     constexpr static float param_visual_particle_color_whiteness { 30.0f };
     constexpr static float param_visual_particle_color_blackness { 0.0f };
+    constexpr static ColorPalette param_visual_particle_palette {
+        ColorPalette::make<Color::HWB>(param_visual_particle_color_whiteness, param_visual_particle_color_blackness)
+    };
 
     /* Emitter Parameters */
     ufd const param_emit_particle_spread_angle_dist { 0.0f, 359.0f };
@@ -37,13 +56,18 @@ public:
     void draw() const;
 
     void emit(uint32_t count, sf::Vector2f const& position);
+    void rebase(sf::Vector2f const& shift) { for (size_t idx = 0; idx < m_count; ++idx) m_particles[idx].shape.move(-shift); }
+    void seed(uint32_t const seed) { m_random = Random{seed}; }
 
-    [[nodiscard]] bool is_active() const { return !m_particles.empty(); }
+    [[nodiscard]] bool is_active() const { return m_count > 0; }
+
+    [[nodiscard]] size_t get_particle_count() const { return m_count; }
+    void save(ParticleSnapshot* snapshots) const; /* writes get_particle_count() entries */
+    void restore(ParticleSnapshot const* snapshots, size_t count);
 
 private:
-    std::vector<Particle> m_particles;
+    Universe& m_universe;
+    std::vector<Particle> m_particles; /* param_max_particles; the first m_count are alive */
+    size_t m_count { 0 };
     Random m_random;
 };
-
-using ParticleEmitter_t = ParticleEmitter;
-extern ParticleEmitter_t ParticleEmitter;
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Entity/Orbit.hpp"
+
+/* A planet's shape & orbit rings; only planets that have been on screen
+ * recently hold one (see Level::update_drawables) */
+struct PlanetDrawable
+{
+    sf::CircleShape shape;
+    sf::CircleShape rings[Orbit::param_visual_ring_count];
+};
+
+/* Recycles drawables of planets that went off screen;
+ * addresses are stable, the pool only grows */
+class PlanetDrawablePool
+{
+public:
+    PlanetDrawablePool() = default;
+
+    PlanetDrawablePool(PlanetDrawablePool const&) = delete;
+    PlanetDrawablePool& operator=(PlanetDrawablePool const&) = delete;
+
+    [[nodiscard]] PlanetDrawable& acquire()
+    {
+        if (m_free.empty())
+        {
+            m_drawables.push_back(std::make_unique<PlanetDrawable>());
+            return *m_drawables.back();
+        }
+
+        PlanetDrawable& drawable { *m_free.back() };
+        m_free.pop_back();
+        return drawable;
+    }
+
+    void release(PlanetDrawable& drawable) { m_free.push_back(&drawable); }
+
+    /* The planets holding them are gone */
+    void release_all()
+    {
+        m_free.clear();
+        for (auto const& drawable : m_drawables) m_free.push_back(drawable.get());
+    }
+
+    [[nodiscard]] size_t get_size() const { return m_drawables.size(); }
+    [[nodiscard]] size_t get_used_count() const { return m_drawables.size() - m_free.size(); }
+
+private:
+    std::vector<std::unique_ptr<PlanetDrawable>> m_drawables;
+    std::vector<PlanetDrawable*> m_free;
+};
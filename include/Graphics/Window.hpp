@@ -19,6 +19,7 @@ public:
           m_internal_resolution{param_window_internal_resolution},
           m_framerate_limit{0}
     {
+        m_target = &m_render_window;
         set_framerate_limit(120);
         m_view.setSize({
             static_cast<float>(m_internal_resolution.x),
@@ -76,19 +77,43 @@ public:
         return m_render_window.isOpen();
     }
 
+    /* Everything drawn goes to `target` instead of the window (see Capture);
+     * nullptr => back to the window */
+    void redirect(sf::RenderTarget* const target)
+    {
+        m_target = target ? target : &m_render_window;
+        apply_view();
+    }
+
+    [[nodiscard]] bool is_redirected() const { return m_target != &m_render_window; }
+
     void clear()
     {
-        m_render_window.clear();
+        m_target->clear();
     }
 
     void draw(sf::Drawable const& drawable)
     {
-        m_render_window.draw(drawable);
+        m_target->draw(drawable);
+    }
+
+    /* Draws in internal resolution screen space; independent of the camera */
+    void draw_overlay(sf::Drawable const& drawable)
+    {
+        sf::View overlay_view { sf::FloatRect{
+            {0.0f, 0.0f},
+            {static_cast<float>(m_internal_resolution.x), static_cast<float>(m_internal_resolution.y)}
+        } };
+        overlay_view.setViewport(get_target_viewport());
+
+        m_target->setView(overlay_view);
+        m_target->draw(drawable);
+        apply_view();
     }
 
     void display()
     {
-        m_render_window.setView(m_view);
+        apply_view();
         m_render_window.display();
     }
 
@@ -110,10 +135,19 @@ public:
     uint32_t get_framerate_limit() const { return m_framerate_limit; }
     void set_framerate_limit(uint32_t const framerate_limit)
     {
-        m_render_window.setFramerateLimit(framerate_limit);
+        m_render_window.setFramerateLimit(m_uncapped ? 0 : framerate_limit);
         m_framerate_limit = framerate_limit;
     }
 
+    /* Uncapped: frames are not limited, but the simulation
+     * still steps by 1 / framerate_limit (see get_delta_time) */
+    bool is_uncapped() const { return m_uncapped; }
+    void set_uncapped(bool const uncapped)
+    {
+        m_uncapped = uncapped;
+        set_framerate_limit(m_framerate_limit);
+    }
+
     float get_delta_time() const { return 1.0f / static_cast<float>(m_framerate_limit); }
 
     ~Window()
@@ -127,10 +161,23 @@ public:
     sf::View& get_view() { return m_view; }
 
 private:
+    /* Letterboxed in the window, the whole of any other target */
+    [[nodiscard]] sf::FloatRect get_target_viewport() const
+    { return is_redirected() ? sf::FloatRect{{0.0f, 0.0f}, {1.0f, 1.0f}} : m_view.getViewport(); }
+
+    void apply_view()
+    {
+        sf::View view { m_view };
+        view.setViewport(get_target_viewport());
+        m_target->setView(view);
+    }
+
     sf::View m_view;
     sf::RenderWindow m_render_window;
+    sf::RenderTarget* m_target;
     sf::Vector2u m_internal_resolution;
     uint32_t m_framerate_limit;
+    bool m_uncapped { false };
 };
 
 using Window_t = Window;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+/* Two body orbit around a heavier body (the focus).
+ * Positions are a function of time alone, solved from Kepler's
+ * equation; nothing is integrated, so nothing drifts however long
+ * it runs, and any tick can be jumped to directly (see Rewind). */
+struct KeplerOrbit
+{
+    float semi_major_axis { 0.0f };
+    float eccentricity { 0.0f }; /* [0, 1) */
+    float periapsis_angle { 0.0f }; /* radians, from +x */
+    float mean_anomaly_at_epoch { 0.0f }; /* radians, at time 0 */
+    float mean_motion { 0.0f }; /* radians per second; negative => clockwise */
+
+    /* Newton steps; converges well below float precision for eccentricity < 0.5 */
+    constexpr static uint32_t param_solver_iterations { 4 };
+
+    /* Kepler's third law; gravitational_parameter = G * mass of the focus */
+    [[nodiscard]] static float get_mean_motion(float gravitational_parameter, float semi_major_axis);
+
+    [[nodiscard]] sf::Vector2f get_offset(double time) const; /* From the focus */
+
+    [[nodiscard]] float get_periapsis() const { return semi_major_axis * (1.0f - eccentricity); }
+    [[nodiscard]] float get_apoapsis() const { return semi_major_axis * (1.0f + eccentricity); }
+};
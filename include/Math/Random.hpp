@@ -1,6 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include "Math/Vector2.hpp"
 
@@ -8,27 +15,110 @@ template <typename T> using uid = std::uniform_int_distribution<T>;
 template <typename T> using urd = std::uniform_real_distribution<T>;
 using ufd = urd<float>;
 
-class Random
+/* xoshiro128++ (Blackman & Vigna); 16 bytes of state, a handful of
+ * ALU ops per number. Satisfies UniformRandomBitGenerator, so the
+ * <random> distributions work with it too.
+ * jump() advances by 2^64 numbers; jumping copies of one engine
+ * gives non-overlapping streams from a single seed (see Swarm). */
+class Xoshiro128
 {
 public:
-    explicit Random(uint32_t const seed)
+    using result_type = uint32_t;
+
+    explicit Xoshiro128(uint64_t seed = 0)
+    {
+        /* splitmix64; never yields the all zero state */
+        for (size_t idx = 0; idx < m_state.size(); idx += 2)
+        {
+            uint64_t z { seed += 0x9e3779b97f4a7c15 };
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            z ^= z >> 31;
+
+            m_state[idx] = static_cast<uint32_t>(z);
+            m_state[idx + 1] = static_cast<uint32_t>(z >> 32);
+        }
+    }
+
+    constexpr static result_type min() { return 0; }
+    constexpr static result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        auto& [s0, s1, s2, s3] { m_state };
+        uint32_t const result { rotl(s0 + s3, 7) + s0 };
+        uint32_t const t { s1 << 9 };
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = rotl(s3, 11);
+
+        return result;
+    }
+
+    void jump()
+    {
+        constexpr uint32_t polynomial[] { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+        std::array<uint32_t, 4> state {};
+        for (uint32_t const word : polynomial)
+            for (uint32_t bit = 0; bit < 32; ++bit)
+            {
+                if (word & (1u << bit))
+                    for (size_t idx = 0; idx < state.size(); ++idx) state[idx] ^= m_state[idx];
+                (*this)();
+            }
+
+        m_state = state;
+    }
+
+private:
+    [[nodiscard]] constexpr static uint32_t rotl(uint32_t const x, int const k)
+    { return (x << k) | (x >> (32 - k)); }
+
+    std::array<uint32_t, 4> m_state;
+};
+
+template <typename Engine>
+class BasicRandom
+{
+public:
+    constexpr static size_t param_batch_size { 64 }; /* Values converted per chunk, where a fill needs scratch space */
+
+    explicit BasicRandom(uint32_t const seed)
         : m_engine(seed) {}
 
-    Random()
+    BasicRandom()
         : m_engine(std::random_device{}()) {}
 
+    /* [0, 1); from the top bits, which are the best ones */
+    template <typename T>
+    T get_unit()
+    {
+        static_assert(std::is_floating_point_v<T>);
+        if constexpr (std::is_same_v<T, float>)
+            return static_cast<float>(next() >> 8) * 0x1.0p-24f;
+        else
+        {
+            uint64_t const high { next() };
+            uint64_t const low { next() };
+            return static_cast<T>(((high << 32 | low) >> 11)) * static_cast<T>(0x1.0p-53);
+        }
+    }
+
     template <typename T>
     T get(urd<T> const& dist)
     {
-        auto& _dist = const_cast<urd<T>&>(dist); /* Bad idea? */
-        return _dist(m_engine);
+        return dist.a() + (dist.b() - dist.a()) * get_unit<T>();
     }
 
     template <typename T>
     T get(uid<T> const& dist)
     {
-        auto& _dist = const_cast<uid<T>&>(dist); /* Bad idea? */
-        return _dist(m_engine);
+        return uid<T>{dist.param()}(m_engine);
     }
 
     template <typename T>
@@ -58,12 +148,68 @@ public:
         };
     }
 
-    template <typename T> T get();
-    template<> bool get() { return get<int32_t>(0, 1); }
+    template <typename T>
+    T get()
+    {
+        static_assert(std::is_same_v<T, bool>);
+        return (next() >> 31) != 0;
+    }
 
     template<typename T = int8_t> /* template for easy casting to any numerical type */
     T sign() { return get<bool>() ? 1 : -1; }
 
+    /* Batch fills; same values, in the same order, as calling get() count times.
+     * The engine runs alone in one loop (its state stays in registers) and leaves
+     * its raw bits in `out`; a second loop, with nothing carried between
+     * iterations, turns them into values and vectorizes */
+    void fill(float* const out, size_t const count, ufd const& dist)
+    {
+        static_assert(sizeof(float) == sizeof(uint32_t));
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            uint32_t const bits { next() };
+            std::memcpy(out + idx, &bits, sizeof(bits));
+        }
+
+        float const min { dist.a() };
+        float const range { dist.b() - dist.a() };
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, out + idx, sizeof(bits));
+            out[idx] = min + range * (static_cast<float>(bits >> 8) * 0x1.0p-24f); /* see get_unit() */
+        }
+    }
+
+    void fill(sf::Angle* const out, size_t const count, ufd const& degrees_dist)
+    {
+        float degrees[param_batch_size];
+        for (size_t first = 0; first < count; first += param_batch_size)
+        {
+            size_t const batch { std::min(count - first, param_batch_size) };
+            fill(degrees, batch, degrees_dist);
+            for (size_t idx = 0; idx < batch; ++idx) out[first + idx] = sf::degrees(degrees[idx]);
+        }
+    }
+
+    /* 32 signs per engine call, from the top bit down;
+     * not the sequence sign() would give */
+    template <typename T>
+    void fill_signs(T* const out, size_t const count)
+    {
+        for (size_t first = 0; first < count; first += 32)
+        {
+            uint32_t bits { next() };
+            size_t const last { std::min(count, first + 32) };
+            for (size_t idx = first; idx < last; ++idx, bits <<= 1)
+                out[idx] = (bits >> 31) ? T{1} : T{-1};
+        }
+    }
+
 private:
-    std::mt19937 m_engine;
-};
\ No newline at end of file
+    uint32_t next() { return static_cast<uint32_t>(m_engine()); } /* std::mt19937's result_type may be wider */
+
+    Engine m_engine;
+};
+
+using Random = BasicRandom<Xoshiro128>;
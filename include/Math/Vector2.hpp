@@ -1,3 +1,89 @@
 #pragma once
 
-#include <SFML/System/Vector2.hpp>
\ No newline at end of file
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+/* Batched math over structure of arrays (SoA) vectors;
+ * for scans over every planet and the like.
+ * Vectorized with AVX2 (ORBIT_AVX2 build option) or SSE2 (any x86-64 build),
+ * scalar otherwise; every backend returns the same results. */
+
+struct Vector2ConstSpan
+{
+    float const* x;
+    float const* y;
+    size_t size;
+};
+
+struct Vector2Span
+{
+    float* x;
+    float* y;
+    size_t size;
+
+    operator Vector2ConstSpan() const { return { x, y, size }; }
+};
+
+struct Vector2Array
+{
+    std::vector<float> x;
+    std::vector<float> y;
+
+    [[nodiscard]] size_t size() const { return x.size(); }
+    void resize(size_t const count) { x.resize(count); y.resize(count); }
+    void clear() { x.clear(); y.clear(); }
+    void push_back(sf::Vector2f const& v) { x.push_back(v.x); y.push_back(v.y); }
+
+    [[nodiscard]] sf::Vector2f get(size_t const idx) const { return { x[idx], y[idx] }; }
+    void set(size_t const idx, sf::Vector2f const& v) { x[idx] = v.x; y[idx] = v.y; }
+
+    [[nodiscard]] Vector2ConstSpan span() const { return { x.data(), y.data(), x.size() }; }
+    [[nodiscard]] Vector2Span span() { return { x.data(), y.data(), x.size() }; }
+};
+
+struct Vector2Nearest
+{
+    constexpr static uint32_t npos { UINT32_MAX };
+
+    uint32_t index { npos }; /* First one, if several are equally near */
+    float distance_squared { 0.0f };
+};
+
+class Vector2Batch
+{
+public:
+    Vector2Batch() = delete;
+
+    constexpr static uint32_t npos { Vector2Nearest::npos };
+
+    [[nodiscard]] static char const* get_backend(); /* "avx2", "sse2" or "scalar" */
+
+    /* out[idx] = |v[idx]|^2 */
+    static void length_squared(Vector2ConstSpan v, float* out);
+
+    /* out[idx] = |points[idx] - from|^2 */
+    static void distance_squared(Vector2ConstSpan points, sf::Vector2f const& from, float* out);
+
+    /* out[idx] = a[idx] . b[idx] */
+    static void dot(Vector2ConstSpan a, Vector2ConstSpan b, float* out);
+
+    /* In place; zero vectors stay zero */
+    static void normalize(Vector2Span v);
+
+    /* out[idx] = v[idx] projected onto onto[idx]; zero where onto[idx] is zero */
+    static void project(Vector2ConstSpan v, Vector2ConstSpan onto, Vector2Span out);
+
+    /* Nearest point to `from`; only where mask[idx] != 0 (if given), never `exclude`.
+     * index == npos if there is no candidate */
+    [[nodiscard]] static Vector2Nearest nearest(
+        Vector2ConstSpan points, sf::Vector2f const& from,
+        uint8_t const* mask = nullptr, uint32_t exclude = npos
+    );
+
+    /* First idx where |points[idx] - from| < radii[idx] + padding; npos if none */
+    [[nodiscard]] static uint32_t first_within(
+        Vector2ConstSpan points, float const* radii, float padding, sf::Vector2f const& from
+    );
+};
@@ -0,0 +1,132 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Core/AllocationTracker.hpp"
+#include "Core/Log.hpp"
+
+namespace
+{
+    /* Constant initialized; safe to use from allocations during static init */
+    std::atomic<uint64_t> total_allocations { 0 };
+    std::atomic<uint64_t> total_deallocations { 0 };
+    std::atomic<uint64_t> total_bytes { 0 };
+}
+
+#ifdef ORBIT_TRACK_ALLOCATIONS
+
+/* The remaining replaceable forms (array, nothrow, sized) forward to these by default;
+ * the aligned forms are left to the standard library */
+void* operator new(std::size_t size)
+{
+    total_allocations.fetch_add(1, std::memory_order_relaxed);
+    total_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (size == 0) size = 1;
+    while (true)
+    {
+        if (void* const ptr { std::malloc(size) }) return ptr;
+
+        std::new_handler const handler { std::get_new_handler() };
+        if (!handler) throw std::bad_alloc{};
+        handler();
+    }
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    if (!ptr) return;
+    total_deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+#endif
+
+AllocationCounts AllocationTracker::get_totals()
+{
+    return {
+        total_allocations.load(std::memory_order_relaxed),
+        total_deallocations.load(std::memory_order_relaxed),
+        total_bytes.load(std::memory_order_relaxed),
+    };
+}
+
+void AllocationTracker::begin_frame()
+{
+    if (!is_enabled) return;
+
+    for (auto& counts : m_scope_current) counts.take();
+    m_frame_start = get_totals();
+}
+
+void AllocationTracker::end_frame(uint32_t const tick, bool const steady_state)
+{
+    if (!is_enabled) return;
+
+    m_last_frame = get_totals() - m_frame_start;
+    for (size_t idx = 0; idx < profile_scope_count; ++idx)
+    {
+        m_scope_last[idx] = m_scope_current[idx].take();
+        m_scope_total[idx] += m_scope_last[idx];
+    }
+    ++m_frames;
+
+    if (!steady_state) return;
+    ++m_steady_frames;
+    m_steady_total += m_last_frame;
+
+    if (!m_steady_state_check || m_last_frame.allocations == 0) return;
+    if (m_violations++ < param_max_reports) report_violation(tick);
+}
+
+void AllocationTracker::report_violation(uint32_t const tick) const
+{
+    {
+        LogLine line { LogLevel::Error, "core/alloc" };
+        line
+            << "tick " << tick << ": " << m_last_frame.allocations
+            << " allocations (" << m_last_frame.bytes << " bytes) in a steady state frame;";
+
+        for (size_t idx = 0; idx < profile_scope_count; ++idx)
+        {
+            if (m_scope_last[idx].allocations == 0) continue;
+            line << " " << profile_scope_names[idx] << "=" << m_scope_last[idx].allocations;
+        }
+    }
+
+    if (m_violations == param_max_reports)
+        ORBIT_LOG(Error, "core/alloc") << "further violations are only counted";
+}
+
+void AllocationTracker::print_summary() const
+{
+    if (!is_enabled || m_frames == 0) return;
+
+    AllocationCounts const totals { get_totals() };
+    ORBIT_LOG(Info, "core/alloc")
+        << "process: " << totals.allocations << " allocations, "
+        << totals.deallocations << " deallocations, " << totals.bytes / 1024 << " KiB";
+
+    {
+        LogLine line { LogLevel::Info, "core/alloc" };
+        line
+            << m_frames << " frames, " << m_steady_frames << " steady state: "
+            << m_steady_total.allocations << " allocations";
+        if (m_steady_state_check) line << ", " << m_violations << " violating frames";
+    }
+
+    for (size_t idx = 0; idx < profile_scope_count; ++idx)
+    {
+        AllocationCounts const& scope { m_scope_total[idx] };
+        if (scope.allocations == 0) continue;
+
+        ORBIT_LOG(Info, "core/alloc")
+            << "  " << profile_scope_names[idx] << ": " << scope.allocations << " allocations ("
+            << static_cast<double>(scope.allocations) / m_frames << "/frame), "
+            << scope.bytes / 1024 << " KiB";
+    }
+}
@@ -1,30 +1,21 @@
-#include <iostream>
 #include "Core/Assist.hpp"
 
-#include "Core/Game.hpp"
+#include "Core/Log.hpp"
 #include "Core/Navigation.hpp"
+#include "Core/Universe.hpp"
 #include "Entity/Planet.hpp"
 #include "Entity/Orbit.hpp"
 #include "Graphics/Window.hpp"
 
-Assist::Assist()
+Assist::Assist(Universe& universe)
+    : m_universe{universe}
 {
-    std::cout
-        << "Navigation::Navigation(): "
-        << "[assist parameters] "
-        << "\n Radial Smoothing Threshold: "
-        << param_assist_radial_smoothing_threshold
-        << "\n Radial Smoothing Factor: "
-        << param_assist_radial_smoothing_factor
-        << "\n Tangent Boosting Factor: "
-        << param_assist_tangent_boosting_factor
-        << "\n Tangent Smoothing Factor: "
-        << param_assist_tangent_smoothing_factor
-        << "\n Tangential Target Velocity: "
-        << Player::param_target_orbital_velocity
-        << "\n Radial Smoothing Ring Size: "
-        << param_assist_radial_smoothing_ring_size
-        << "\n";
+    ORBIT_LOG(Debug, "core/assist") << "Radial Smoothing Threshold: " << param_assist_radial_smoothing_threshold;
+    ORBIT_LOG(Debug, "core/assist") << "Radial Smoothing Factor: " << param_assist_radial_smoothing_factor;
+    ORBIT_LOG(Debug, "core/assist") << "Tangent Boosting Factor: " << param_assist_tangent_boosting_factor;
+    ORBIT_LOG(Debug, "core/assist") << "Tangent Smoothing Factor: " << param_assist_tangent_smoothing_factor;
+    ORBIT_LOG(Debug, "core/assist") << "Tangential Target Velocity: " << Player::param_target_orbital_velocity;
+    ORBIT_LOG(Debug, "core/assist") << "Radial Smoothing Ring Size: " << param_assist_radial_smoothing_ring_size;
 }
 
 void Assist::draw() const
@@ -36,30 +27,20 @@ void Assist::draw() const
 
 void Assist::update()
 {
-    if (!m_player) m_player = &Game.get_player();
-    assert(m_player);
-
-    float const dt { Window.get_delta_time() };
-    auto& ctx { Navigation.get_context() };
+    Player& player { m_universe.get_player() };
+    float const dt { m_universe.get_delta_time() };
+    auto& ctx { m_universe.get_navigation().get_context() };
 
     Planet& target_planet { ctx.target_planet };
     Orbit const& target_orbit { ctx.target_orbit };
 
     float const target_radius { target_orbit.get_radius() };
-    auto const orbit_origin { target_orbit.get_origin() };
-
-    init_target_radius_ring(
-        orbit_origin,
-        target_radius
-    );
-
-    init_smoothing_ring_shape(orbit_origin);
 
     auto v_radial { ctx.player_radial_v };
     auto v_tangent { ctx.player_tangent_v };
 
     /* Planet Mass Boosting */
-    if (m_player->is(PlayerState::FarOutsideOrbit))
+    if (player.is(PlayerState::FarOutsideOrbit))
     {
         target_planet.set_mass(
             (1.0f + param_assist_planet_mass_boosting_power) *
@@ -67,15 +48,15 @@ void Assist::update()
         );
     }
 
-    /* Everything beyond this is only applied if the player is in the smoothing ring */
-    if (!m_player->is(PlayerState::InsideSmoothingRing)) return;
-
-    if (v_radial.length() > param_assist_radial_smoothing_threshold)
-        return; // Other assistance is not provided if radial smoothing did not happen
+    /* Everything beyond this is only applied if the player is in the smoothing ring;
+     * other assistance is not provided if radial smoothing did not happen */
+    bool const smoothing {
+        player.is(PlayerState::InsideSmoothingRing)
+        && v_radial.length() <= param_assist_radial_smoothing_threshold
+    };
 
-    // Show that the smoothing ring is active
-    m_smoothing_ring_inner.setOutlineColor(sf::Color::Yellow);
-    m_smoothing_ring_outer.setOutlineColor(sf::Color::Yellow);
+    set_smoothing_ring_active(smoothing); // Show that the smoothing ring is active
+    if (!smoothing) return;
 
     /* Radial Smoothing */
     v_radial *= std::pow(param_assist_radial_smoothing_factor, dt);
@@ -103,7 +84,35 @@ void Assist::update()
         / Navigation::G
     );
 
-    m_player->set_velocity(v_radial + v_tangent);
+    player.set_velocity(v_radial + v_tangent);
+}
+
+void Assist::on_navigation_event(NavigationEvent const& event)
+{
+    if (event.type != NavigationEventType::TargetChanged) return;
+
+    /* Ring geometry only depends on the target orbit */
+    Orbit const& target_orbit { event.planet->get_orbit() };
+    init_target_radius_ring(target_orbit.get_origin(), target_orbit.get_radius());
+    init_smoothing_ring_shape(target_orbit.get_origin());
+    m_smoothing_ring_active = false;
+}
+
+void Assist::rebase(sf::Vector2f const& shift)
+{
+    m_target_radius_ring.move(-shift);
+    m_smoothing_ring_inner.move(-shift);
+    m_smoothing_ring_outer.move(-shift);
+}
+
+void Assist::set_smoothing_ring_active(bool const active)
+{
+    if (active == m_smoothing_ring_active) return;
+    m_smoothing_ring_active = active;
+
+    sf::Color const color { active ? sf::Color::Yellow : sf::Color::Green };
+    m_smoothing_ring_inner.setOutlineColor(color);
+    m_smoothing_ring_outer.setOutlineColor(color);
 }
 
 void Assist::init_target_radius_ring(sf::Vector2f const& position, float const radius)
@@ -1,36 +1,43 @@
+#include <algorithm>
 #include "Core/Collision.hpp"
 #include "Core/Level.hpp"
 #include "Math/Vector2.hpp"
 
-bool Collision::with_any_planet(sf::Shape const& shape)
+bool Collision::with_any_planet(Level const& level, sf::Shape const& shape)
 {
-    auto const& planets { Level.get_planets() };
-    return std::any_of(
-        planets.begin(),
-        planets.end(),
-        [&shape](auto const& planet)
-        { return with_planet(planet.get_info(), shape); }
-    );
+    auto const& planets { level.get_planets() };
+    auto const& position { level.get_planet_arrays().position };
+
+    /* Only planets near the shape's bounds; cheap circle vs. box rejection first */
+    sf::FloatRect const bounds { shape.getGlobalBounds() };
+    sf::Vector2f const min { bounds.position };
+    sf::Vector2f const max { bounds.position + bounds.size };
+    sf::Vector2f const reach { level.get_max_planet_radius(), level.get_max_planet_radius() };
+
+    return level.get_index().any_in(min - reach, max + reach, [&](uint32_t const idx)
+    {
+        float const x { position.x[idx] };
+        float const y { position.y[idx] };
+        float const dx { std::max({ min.x - x, 0.0f, x - max.x }) };
+        float const dy { std::max({ min.y - y, 0.0f, y - max.y }) };
+        float const radius { planets[idx].get_info().radius };
+        if (dx * dx + dy * dy >= radius * radius) return false;
+
+        return with_planet(planets[idx].get_info(), shape);
+    });
 }
 
 bool Collision::with_planet(PlanetInfo const& planet, sf::Shape const& shape)
 {
     auto const& shape_transform { shape.getTransform() };
 
-    // Get shape's vertices in world coordinates
+    // Check if any of the shape's vertices (in world coordinates) is inside the planet's circle;
+    // transformed one at a time, so that nothing is allocated (any thread may call this)
     size_t const vertex_count { shape.getPointCount() };
-    std::vector<sf::Vector2f> shape_vertices;
-    shape_vertices.reserve(vertex_count);
     for (size_t idx = 0; idx < vertex_count; ++idx)
-        shape_vertices.push_back(
-            shape_transform * shape.getPoint(idx)
-        );
-
-    // Check if any shape vertex is inside the planet's circle
-    return std::any_of(
-        shape_vertices.begin(),
-        shape_vertices.end(),
-        [&planet](auto const& v)
-        {return (v - planet.position).length() < planet.radius;}
-    );
-}
\ No newline at end of file
+    {
+        sf::Vector2f const v { shape_transform * shape.getPoint(idx) };
+        if ((v - planet.position).length() < planet.radius) return true;
+    }
+    return false;
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include "Core/FrameArena.hpp"
+#include "Core/Log.hpp"
+
+FrameArena::FrameArena()
+    : m_block{std::make_unique<std::byte[]>(param_initial_capacity)}, m_capacity{param_initial_capacity} {}
+
+FrameArena::~FrameArena() = default;
+
+void FrameArena::reset()
+{
+    /* Outgrown; make the next frames fit (only happens while warming up) */
+    if (m_frame_high_water > m_capacity)
+    {
+        size_t capacity { m_capacity };
+        while (capacity < m_frame_high_water) capacity *= 2;
+
+        m_block = std::make_unique<std::byte[]>(capacity);
+        m_capacity = capacity;
+    }
+
+    m_offset = 0;
+    m_frame_high_water = 0;
+    m_overflow_bytes = 0;
+}
+
+void* FrameArena::do_allocate(size_t const bytes, size_t const alignment)
+{
+    auto const base { reinterpret_cast<uintptr_t>(m_block.get()) };
+    size_t const start { ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base };
+
+    void* ptr { nullptr };
+    if (start + bytes <= m_capacity)
+    {
+        ptr = m_block.get() + start;
+        m_offset = start + bytes;
+    }
+    else
+    {
+        ORBIT_LOG_EVERY(Warning, "core/arena", 1000)
+            << "frame arena full (" << m_capacity / 1024 << " KiB); " << bytes << " bytes from the heap";
+
+        ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        m_overflow_bytes += bytes;
+        ++m_overflow_count;
+    }
+
+    m_frame_high_water = std::max(m_frame_high_water, m_offset + m_overflow_bytes);
+    m_high_water = std::max(m_high_water, m_frame_high_water);
+    return ptr;
+}
+
+void FrameArena::do_deallocate(void* const ptr, size_t const bytes, size_t const alignment)
+{
+    auto* const byte_ptr { static_cast<std::byte*>(ptr) };
+    auto const base { reinterpret_cast<uintptr_t>(m_block.get()) };
+    auto const address { reinterpret_cast<uintptr_t>(ptr) };
+    bool const in_block { address >= base && address < base + m_capacity };
+
+    /* Heap fallback; back to where it came from */
+    if (!in_block) return std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+
+    /* Only the top of the stack can be given back early */
+    if (byte_ptr + bytes == m_block.get() + m_offset)
+        m_offset = static_cast<size_t>(byte_ptr - m_block.get());
+}
+
+void FrameArena::print() const
+{
+    ORBIT_LOG(Info, "core/arena")
+        << "high water: " << m_high_water / 1024.0 << " KiB of " << m_capacity / 1024 << " KiB, "
+        << m_overflow_count << " heap fallbacks";
+}
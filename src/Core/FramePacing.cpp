@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "Core/FramePacing.hpp"
+#include "Core/Log.hpp"
+#include "Graphics/Overlay.hpp"
+#include "Graphics/Window.hpp"
+
+uint32_t FrameTimeHistogram::get_index(uint64_t const microseconds)
+{
+    if (microseconds < 2 * sub_bucket_count) return static_cast<uint32_t>(microseconds);
+
+    uint32_t msb { 0 };
+    while (microseconds >> (msb + 1)) ++msb;
+
+    uint32_t const shift { msb - param_sub_bucket_bits }; // value >> shift lands in [sub_bucket_count, 2 * sub_bucket_count)
+    if (shift > param_max_shift) return bucket_count - 1;
+
+    auto const sub_bucket { static_cast<uint32_t>(microseconds >> shift) - sub_bucket_count };
+    return 2 * sub_bucket_count + (shift - 1) * sub_bucket_count + sub_bucket;
+}
+
+uint64_t FrameTimeHistogram::get_upper_bound(uint32_t const index)
+{
+    if (index < 2 * sub_bucket_count) return index;
+
+    uint32_t const offset { index - 2 * sub_bucket_count };
+    uint32_t const shift { offset / sub_bucket_count + 1 };
+    uint64_t const sub_bucket { offset % sub_bucket_count + sub_bucket_count };
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void FrameTimeHistogram::record(uint64_t const microseconds)
+{
+    ++m_buckets[get_index(microseconds)];
+    ++m_count;
+    m_max = std::max(m_max, microseconds);
+}
+
+uint64_t FrameTimeHistogram::get_percentile(double const p) const
+{
+    if (m_count == 0) return 0;
+
+    auto const rank { std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(m_count)))) };
+    uint64_t seen { 0 };
+    for (uint32_t idx = 0; idx < bucket_count; ++idx)
+    {
+        seen += m_buckets[idx];
+        if (seen >= rank) return std::min(get_upper_bound(idx), m_max);
+    }
+    return m_max;
+}
+
+void FramePacing::record(uint64_t const update_us, uint64_t const render_us, uint64_t const display_us, bool const rendered)
+{
+    m_histograms[static_cast<size_t>(FramePhase::Update)].record(update_us);
+    if (rendered)
+    {
+        m_histograms[static_cast<size_t>(FramePhase::Render)].record(render_us);
+        m_histograms[static_cast<size_t>(FramePhase::Display)].record(display_us);
+    }
+
+    uint64_t const frame_us { update_us + render_us + display_us };
+    m_histograms[static_cast<size_t>(FramePhase::Frame)].record(frame_us);
+
+    float const budget_us { 1e6f * Window.get_delta_time() * param_budget_slack_factor };
+    if (static_cast<float>(frame_us) > budget_us) ++m_budget_misses;
+
+    if (m_overlay_enabled) rebuild_overlay();
+}
+
+void FramePacing::print() const
+{
+    uint64_t const frames { get(FramePhase::Frame).get_count() };
+    if (frames == 0) return;
+
+    char row[96];
+    std::snprintf(row, sizeof(row), "%.2fms budget (%.2f%%)", 1000.0f * Window.get_delta_time(),
+        100.0 * static_cast<double>(m_budget_misses) / static_cast<double>(frames));
+    ORBIT_LOG(Info, "core/pacing") << frames << " frames, " << m_budget_misses << " over the " << row;
+    ORBIT_LOG(Info, "core/pacing") << "  phase          p50      p90      p99    p99.9      max (ms)";
+
+    for (size_t idx = 0; idx < phase_count; ++idx)
+    {
+        FrameTimeHistogram const& histogram { m_histograms[idx] };
+        if (histogram.get_count() == 0) continue;
+
+        int length { std::snprintf(row, sizeof(row), "  %-9s", phase_names[idx]) };
+        for (double const p : percentiles)
+            length += std::snprintf(row + length, sizeof(row) - length, "%9.2f",
+                static_cast<double>(histogram.get_percentile(p)) / 1000.0);
+        std::snprintf(row + length, sizeof(row) - length, "%9.2f", static_cast<double>(histogram.get_max()) / 1000.0);
+        ORBIT_LOG(Info, "core/pacing") << row;
+    }
+}
+
+void FramePacing::rebuild_overlay()
+{
+    m_overlay.clear();
+
+    float const budget_us { 1e6f * Window.get_delta_time() };
+    float const scale { param_visual_bar_max_width / (2.0f * budget_us) };
+    sf::Vector2f const origin { param_visual_overlay_origin };
+
+    /* One row per phase; percentile bars longest (faintest) first */
+    for (size_t phase = 0; phase < phase_count; ++phase)
+    {
+        float const y { origin.y + static_cast<float>(phase) * param_visual_row_height };
+        Overlay::append_rect(m_overlay, {origin.x, y}, {param_visual_bar_max_width, param_visual_row_height}, param_visual_background_color);
+
+        for (size_t p = std::size(percentiles); p-- > 0; )
+        {
+            auto const value { static_cast<float>(m_histograms[phase].get_percentile(percentiles[p])) };
+            sf::Color color { param_visual_phase_colors[phase] };
+            color.a = static_cast<uint8_t>(255 / (p + 1));
+
+            Overlay::append_rect(
+                m_overlay, {origin.x, y + 3.0f},
+                {std::min(value * scale, param_visual_bar_max_width), param_visual_row_height - 6.0f},
+                color
+            );
+        }
+    }
+
+    /* Budget misses, as a fraction of the width */
+    float const rows_height { param_visual_row_height * phase_count };
+    uint64_t const frames { get(FramePhase::Frame).get_count() };
+    float const miss_ratio { frames ? static_cast<float>(m_budget_misses) / static_cast<float>(frames) : 0.0f };
+    Overlay::append_rect(m_overlay, {origin.x, origin.y + rows_height}, {miss_ratio * param_visual_bar_max_width, 6.0f}, param_visual_budget_color);
+
+    /* Frame budget marker */
+    Overlay::append_rect(m_overlay, {origin.x + budget_us * scale, origin.y}, {2.0f, rows_height}, param_visual_budget_color);
+}
+
+void FramePacing::draw() const
+{
+    if (!m_overlay_enabled) return;
+    Window.draw_overlay(m_overlay);
+}
@@ -1,42 +1,171 @@
 #include <optional>
+#include <random>
 
 #include "Core/Game.hpp"
-#include "Core/Level.hpp"
-#include "Core/Navigation.hpp"
-#include "Core/Assist.hpp"
+#include "Core/AllocationTracker.hpp"
+#include "Core/FramePacing.hpp"
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Replay.hpp"
+#include "Core/Startup.hpp"
+#include "Core/Trace.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Universe.hpp"
 #include "Graphics/Window.hpp"
 #include "Graphics/Camera.hpp"
-#include "Graphics/Particles.hpp"
+#include "Graphics/Capture.hpp"
+#include "Graphics/Overlay.hpp"
 #include "Math/Vector2.hpp"
 
+/* Constructed first & destroyed last; anything may log */
+Log_t Log;
+
+/* Before the window opens; times startup from here */
+Startup_t Startup;
+
 /* Graphics Managers */
 Window_t Window;
 Camera_t Camera;
-ParticleEmitter_t ParticleEmitter;
+Capture_t Capture; /* After the window; its render texture needs the GL context */
+
+/* Process wide services; everything per simulation lives in a Universe */
+Profiler_t Profiler;
+Trace_t Trace;
+AllocationTracker_t AllocationTracker;
+FramePacing_t FramePacing;
+Replay_t Replay;
+ThreadPool_t ThreadPool;
+
+bool Game::init(GameOptions const& options)
+{
+    Startup.mark(StartupPhase::Main);
+    m_headless = options.headless;
+    m_trace_path = options.trace_path;
+
+    AllocationTracker.set_steady_state_check(options.allocation_check);
+    if (options.allocation_check && !AllocationTracker_t::is_enabled)
+        ORBIT_LOG(Warning, "core/alloc") << "built without ORBIT_TRACK_ALLOCATIONS; nothing to check";
+    Window.set_uncapped(options.uncapped);
+
+    /* Every source of randomness is seeded from here;
+     * so that a session can be reproduced from its seeds + inputs */
+    std::random_device seed_source;
+    ReplaySeeds seeds { seed_source(), seed_source(), seed_source() };
+    LevelConfig level_config { options.level };
+
+    if (!options.replay_path.empty())
+    {
+        if (!Replay.load(options.replay_path)) return false;
+        seeds = Replay.get_seeds();
+        level_config = Replay.get_level_config();
+        Window.set_framerate_limit(Replay.get_tick_rate()); // same dt as the recording
+    }
+
+    m_universe.set_tick_rate(Window.get_framerate_limit());
+    m_universe.set_thread_pool(&ThreadPool); /* Main thread keeps the window; the pool takes the rest */
+    m_universe.get_navigation().subscribe([this](NavigationEvent const& event) { on_navigation_event(event); });
+    m_universe.get_origin().subscribe([](sf::Vector2f const& shift) { Camera.rebase(shift); });
 
-/* Core Managers */
-Navigation_t Navigation;
-Assist_t Assist;
-Level_t Level;
+    Level& level { m_universe.get_level() };
+    level.set_config(level_config);
+    m_universe.get_origin().reset();
+    level.generate_async(seeds.level); /* see load() */
+    m_universe.seed(seeds);
 
-/* Game Manager */
-Game_t Game;
+    m_seeds = seeds;
+    return true;
+}
 
-Game::Game()
+bool Game::load(GameOptions const& options)
 {
-    Level.generate();
+    Level& level { m_universe.get_level() };
+
+    /* Only closing & resizing are handled until the level is placed */
+    while (!m_headless && !level.is_generated())
+    {
+        while (const std::optional event { Window.poll_event() })
+        {
+            if (event->is<sf::Event::Closed>())
+            {
+                level.finish_generate();
+                return false;
+            }
+
+            if (auto const* resized { event->getIf<sf::Event::Resized>() })
+                Window.handle_resize(resized->size);
+        }
+
+        render_loading();
+        display();
+        Startup.mark(StartupPhase::LoadingView);
+    }
+
+    level.finish_generate();
+    Startup.mark(StartupPhase::Level);
+
+    /* Anything else is built once it comes into view; nothing is drawn when headless */
+    if (!m_headless) level.update_drawables(Window.get_view());
+    Startup.mark(StartupPhase::Neighborhood);
+
+    m_universe.get_rewind().init();
+
+    if (!options.record_path.empty())
+        Replay.start_recording(options.record_path, m_seeds, level.get_config(), m_universe.get_tick_rate());
+
+    if (!options.capture_path.empty())
+        Capture.start(options.capture_path, options.capture_every, options.capture_format);
+
+    return true;
 }
 
-void Game::run()
+void Game::run(GameOptions const& options)
 {
+    if (!init(options) || !load(options)) return;
+
+    sf::Clock session_clock;
     while (Window.is_open())
     {
         bool const exit_signal { process_events() };
-        if (exit_signal) break;
+        if (exit_signal || Replay.is_finished(m_tick)) break;
+
+        AllocationTracker.begin_frame();
+        bool const steady_state { is_steady_state() };
 
+        sf::Clock phase_clock;
         update();
-        render();
+        auto const update_us { phase_clock.restart().asMicroseconds() };
+
+        if (!m_headless || Capture.wants(m_tick)) render();
+        auto const render_us { phase_clock.restart().asMicroseconds() };
+
+        if (!m_headless) display();
+        auto const display_us { phase_clock.getElapsedTime().asMicroseconds() };
+        if (m_tick == 0) Startup.mark(StartupPhase::FirstFrame);
+
+        FramePacing.record(update_us, render_us, display_us, !m_headless);
+        AllocationTracker.end_frame(m_tick, steady_state && is_steady_state());
+        Profiler.end_frame();
+        ++m_tick;
     }
+
+    if (Replay.is_recording()) Replay.stop_recording(m_tick);
+    Capture.flush();
+    Capture.print();
+    if (!m_trace_path.empty()) Trace.dump(m_trace_path);
+    AllocationTracker.print_summary();
+    Startup.print();
+    FramePacing.print();
+    m_universe.get_frame_arena().print();
+
+    if (Replay.is_playing())
+    {
+        float const seconds { session_clock.getElapsedTime().asSeconds() };
+        ORBIT_LOG(Info, "core/replay")
+            << "replayed " << m_tick << " ticks in " << seconds << "s ("
+            << static_cast<float>(m_tick) / seconds << " ticks/s)";
+    }
+
+    Log.flush();
 }
 
 bool Game::process_events()
@@ -48,6 +177,8 @@ bool Game::process_events()
         if (auto const* resized { event->getIf<sf::Event::Resized>() })
             Window.handle_resize(resized->size);
 
+        if (Replay.is_playing()) continue; /* only recorded inputs drive a replay */
+
         if (auto const* key { event->getIf<sf::Event::KeyPressed>() })
             process_keypress(*key);
 
@@ -57,42 +188,123 @@ bool Game::process_events()
         if (auto const* mouse { event->getIf<sf::Event::MouseButtonPressed>() })
             process_mouse_click(*mouse);
     }
+
+    process_replay_inputs();
     return false;
 }
 
+void Game::process_replay_inputs()
+{
+    ReplayInput input;
+    while (Replay.next(m_tick, input))
+    {
+        switch (input.type)
+        {
+        case ReplayInputType::KeyPressed:
+        {
+            sf::Event::KeyPressed key {};
+            key.code = input.key;
+            process_keypress(key);
+            break;
+        }
+        case ReplayInputType::MouseClick: process_mouse_click({}); break;
+        case ReplayInputType::MouseSeek: seek_camera(input.position); break;
+        }
+    }
+}
+
 void Game::process_keypress(sf::Event::KeyPressed const& key)
 {
+    Replay.record({ .tick = m_tick, .type = ReplayInputType::KeyPressed, .key = key.code });
+
     if (key.code == sf::Keyboard::Key::P) // toggle pause
         m_paused = !m_paused;
 
     if (m_paused) return; /* do not process other inputs while paused */
 
     if (key.code == sf::Keyboard::Key::Space) // release player
-        Navigation.release_player_from_orbit();
+    {
+        ORBIT_TRACE_INSTANT("release");
+        m_universe.get_navigation().release_player_from_orbit();
+    }
+
+    if (key.code == sf::Keyboard::Key::H) // toggle launch window hint
+        m_universe.get_launch_solver().toggle_hint();
+
+    if (key.code == sf::Keyboard::Key::C) // screenshot (next frame)
+        Capture.request_screenshot();
+
+    if (key.code == sf::Keyboard::Key::Z) // toggle rewind
+    {
+        ORBIT_TRACE_INSTANT("rewind");
+        Rewind& rewind { m_universe.get_rewind() };
+        if (!rewind.is_rewinding()) return rewind.start();
+
+        rewind.stop();
+        if (m_debug_mode)
+            ORBIT_LOG(Debug, "core/rewind")
+                << rewind.get_count() << " snapshots left, last restore: "
+                << rewind.get_last_restore_us() << "us";
+        return;
+    }
 
     /* Debug Cheats */
     if (key.code == sf::Keyboard::Key::D) // toggle debug
-        { m_debug_mode = !m_debug_mode; return; }
+    {
+        m_debug_mode = !m_debug_mode;
+        Profiler.set_overlay_enabled(m_debug_mode);
+        FramePacing.set_overlay_enabled(m_debug_mode);
+        return;
+    }
 
     if (!m_debug_mode) return;
 
+    Player& player { m_universe.get_player() };
+
     if (key.code == sf::Keyboard::Key::R)
-        return m_player.reset();
+        return player.reset();
 
     if (key.code == sf::Keyboard::Key::I)
-        return m_player.invert_velocity();
+        return player.invert_velocity();
+
+    if (key.code == sf::Keyboard::Key::B) // bot swarm load test
+    {
+        Swarm& swarm { m_universe.get_swarm() };
+        if (swarm.is_sweeping()) return swarm.stop_sweep();
+        return swarm.start_sweep();
+    }
+
+    if (key.code == sf::Keyboard::Key::L) // level playability check (logged when done)
+        return m_universe.get_launch_solver().start_playability_check();
+
+    if (key.code == sf::Keyboard::Key::F) // startup, profiler, frame pacing & arena numbers (the overlays have no labels)
+    {
+        Startup.print();
+        m_universe.get_level().print_drawables();
+        Profiler.print();
+        FramePacing.print();
+        return m_universe.get_frame_arena().print();
+    }
+
+    if (key.code == sf::Keyboard::Key::J) // frame timeline capture (Chrome trace JSON)
+    {
+        Trace.dump(m_trace_path.empty() ? std::filesystem::path{Trace_t::param_default_path} : m_trace_path);
+        return;
+    }
 
     if (key.code == sf::Keyboard::Key::T)
     {
-        auto& ctx { Navigation.get_context() };
-        ctx.target_orbit.turn_off();
-        Navigation.force_reload(); // target orbit has changed
-        return m_player.reset(); // teleport to nearest orbit
+        Navigation& navigation { m_universe.get_navigation() };
+        navigation.get_context().target_orbit.turn_off();
+        navigation.force_reload(); // target orbit has changed
+        return player.reset(); // teleport to nearest orbit
     }
 }
 
 void Game::process_mouse_click(sf::Event::MouseButtonPressed const& _)
 {
+    Replay.record({ .tick = m_tick, .type = ReplayInputType::MouseClick });
+
     /* Toggles camera mode */
     if (Camera.is_locked())
     {
@@ -105,6 +317,7 @@ void Game::process_mouse_click(sf::Event::MouseButtonPressed const& _)
     Camera.set_follow_smoothing_power( /* Seek mode */
         Camera::param_seek_follow_smoothing_power
     );
+    Camera.set_target(Camera.get_target()); // hold still until the mouse moves
     Camera.lock();
 }
 
@@ -113,9 +326,12 @@ void Game::process_mouse_move(sf::Event::MouseMoved const& mouse)
     /* Handles camera's seek mode */
     if (!Camera.is_locked()) return; // Seek mode OFF.
 
-    auto const& position {
-        Window.map_pixel_to_coords(mouse.position)
-    };
+    seek_camera(Window.map_pixel_to_coords(mouse.position));
+}
+
+void Game::seek_camera(sf::Vector2f const& position)
+{
+    Replay.record({ .tick = m_tick, .type = ReplayInputType::MouseSeek, .position = position });
 
     Camera.unlock();
     Camera.set_target(position);
@@ -125,42 +341,106 @@ void Game::process_mouse_move(sf::Event::MouseMoved const& mouse)
 void Game::update()
 {
     if (m_paused) return;
+    ORBIT_TRACE_SCOPE("update");
 
-    if (ParticleEmitter.is_active())
-        /* Block the update loop
-         * while the particle emitter is active
-         * FIXME: process_input() is still being called */
-        return ParticleEmitter.update();
-
+    m_universe.update();
+    Camera.update();
+}
 
-    Navigation.update();
-    Assist.update();
+void Game::on_navigation_event(NavigationEvent const& event)
+{
+    switch (event.type)
+    {
+    case NavigationEventType::Captured: ORBIT_TRACE_INSTANT("captured"); return;
+    case NavigationEventType::Escaped: ORBIT_TRACE_INSTANT("escaped"); return;
+    case NavigationEventType::Exploded: ORBIT_TRACE_INSTANT("exploded"); return;
 
-    auto const& ctx { Navigation.get_context() };
-    auto& target_orbit { ctx.target_orbit };
+    case NavigationEventType::TargetChanged:
+        ORBIT_TRACE_INSTANT("target changed");
+        if (event.other) event.other->get_orbit().clear_highlight(); // No longer pulling the player
+        return retarget_camera();
 
-    target_orbit.update();
-    m_player.update();
+    case NavigationEventType::EnteredFarOutside:
+    case NavigationEventType::LeftFarOutside:
+        return retarget_camera();
 
-    Camera.update();
+    default: return;
+    }
+}
 
-    /* Follow player from the next frame
+void Game::retarget_camera()
+{
+    /* Follow player (from the next frame)
      * if it is far outside the orbit of any planet */
-    Camera.set_target(target_orbit.get_origin());
-    if (m_player.is(PlayerState::FarOutsideOrbit))
-        Camera.set_target(m_player.get_position());
+    Player const& player { m_universe.get_player() };
+    if (player.is(PlayerState::FarOutsideOrbit))
+        return Camera.follow(player.get_position());
+
+    Camera.follow(m_universe.get_navigation().get_context().target_orbit.get_origin());
 }
 
-void Game::render() const
+bool Game::is_steady_state() const
 {
-    Window.clear();
-    ParticleEmitter.draw();
+    /* Player orbiting undisturbed; no explosion, rewind, bots or launch solves */
+    return
+        !m_paused
+        && m_universe.get_navigation().has_context()
+        && m_universe.get_player().is(PlayerState::InStableOrbit)
+        && !m_universe.get_particles().is_active()
+        && !m_universe.get_rewind().is_rewinding()
+        && !m_universe.get_swarm().is_active()
+        && !m_universe.get_launch_solver().is_hint_enabled()
+        && !m_universe.get_launch_solver().is_checking_playability();
+}
+
+void Game::render()
+{
+    ORBIT_TRACE_SCOPE("render");
+    bool const captured { Capture.begin_frame(m_tick) }; /* Offscreen, then shown in the window */
+
+    {
+        ORBIT_PROFILE_SCOPE(RenderWorld);
+
+        Level& level { m_universe.get_level() };
+
+        Window.clear();
+        m_universe.get_particles().draw();
+
+        level.update_drawables(Window.get_view());
+        level.draw();
+
+        if (m_debug_mode) m_universe.get_assist().draw();
+        m_universe.get_prediction().draw();
+        m_universe.get_launch_solver().draw();
+        m_universe.get_swarm().draw();
+        m_universe.get_player().draw();
+    }
+
+    {
+        ORBIT_PROFILE_SCOPE(RenderOverlay);
+        Profiler.draw();
+        FramePacing.draw();
+    }
 
-    for (auto const& planet : Level.get_planets())
-        planet.draw();
+    if (captured) Capture.end_frame(!m_headless);
+}
 
-    if (m_debug_mode) Assist.draw();
-    m_player.draw();
+void Game::render_loading() const
+{
+    sf::Vector2f const resolution { Window.get_internal_resolution() };
+    sf::Vector2f const size { resolution.x * param_visual_loading_bar_width, param_visual_loading_bar_height };
+    sf::Vector2f const position { (resolution - size) / 2.0f };
 
+    sf::VertexArray bar { sf::PrimitiveType::Triangles };
+    Overlay::append_rect(bar, position, size, param_visual_loading_bar_background);
+    Overlay::append_rect(bar, position, { size.x * m_universe.get_level().get_generate_progress(), size.y }, param_visual_loading_bar_color);
+
+    Window.clear();
+    Window.draw_overlay(bar);
+}
+
+void Game::display() const
+{
+    ORBIT_PROFILE_SCOPE(Display);
     Window.display();
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include "Core/LaunchSolver.hpp"
+#include "Core/Level.hpp"
+#include "Core/Log.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Universe.hpp"
+#include "Entity/Player.hpp"
+#include "Graphics/Window.hpp"
+#include "Math/Vector2.hpp"
+
+void LaunchSearch::start(
+    ShipState const& start, float const orbit_radius, float const dt,
+    uint32_t const candidate_count, bool const stop_at_first
+)
+{
+    assert(start.target != ShipState::npos);
+
+    constexpr float pi { 3.14159265f };
+    float const period { 2.0f * pi * orbit_radius / Player::param_target_orbital_velocity };
+
+    m_started = true;
+    m_stop_at_first = stop_at_first;
+    m_candidate_count = candidate_count;
+    m_period_ticks = static_cast<uint32_t>(std::ceil(period / dt));
+
+    m_ship = start;
+    m_tick = 0;
+    m_walked = false;
+
+    /* Capacity stays; a restart (new target) does not allocate */
+    m_releases.clear();
+    m_release_ticks.clear();
+    m_releases.reserve(candidate_count);
+    m_release_ticks.reserve(candidate_count);
+    m_evaluated_prefix = 0;
+
+    m_solution.windows.clear();
+    m_solution.candidates_evaluated = 0;
+    m_solution.complete = false;
+}
+
+bool LaunchSearch::resume(Level const& level, float const dt, float const budget_ms)
+{
+    assert(m_started);
+    if (m_solution.complete) return true;
+
+    bool const has_budget { budget_ms > 0.0f };
+    auto const deadline {
+        Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float, std::milli>{budget_ms}
+        )
+    };
+
+    if (walk(level, dt, has_budget, deadline)) fly(level, dt, has_budget, deadline);
+    collect();
+
+    return m_solution.complete;
+}
+
+bool LaunchSearch::walk(Level const& level, float const dt, bool const has_budget, Clock::time_point const deadline)
+{
+    if (m_walked) return true;
+
+    auto const& planets { level.get_planets() };
+    auto const& arrays { level.get_planet_arrays() };
+
+    /* Pre-release: follow the current orbit once (serially),
+     * recording the state at each sampled release phase */
+    uint32_t steps { 0 };
+    while (m_releases.size() < m_candidate_count)
+    {
+        auto const candidate { static_cast<uint32_t>(m_releases.size()) };
+        uint32_t const release_tick { candidate * m_period_ticks / m_candidate_count };
+
+        for (; m_tick < release_tick; ++m_tick)
+        {
+            if (
+                has_budget && ++steps % LaunchSolver::param_budget_check_interval == 0
+                && Clock::now() > deadline
+            ) return false; /* Carries on from m_tick next time */
+
+            ShipEvent const event { Simulation::step(m_ship, dt, planets, arrays) };
+            if (event == ShipEvent::Collided || event == ShipEvent::Lost)
+                return finish_walk(); /* Orbit broke up; later phases never come */
+        }
+
+        m_releases.push_back(m_ship);
+        m_release_ticks.push_back(m_tick);
+    }
+
+    return finish_walk();
+}
+
+bool LaunchSearch::finish_walk()
+{
+    /* One slot per release found; fewer than m_candidate_count if the orbit broke up */
+    m_results.assign(m_releases.size(), std::nullopt);
+    m_evaluated.assign(m_releases.size(), 0);
+
+    m_walked = true;
+    return true;
+}
+
+void LaunchSearch::fly(Level const& level, float const dt, bool const has_budget, Clock::time_point const deadline)
+{
+    auto const& planets { level.get_planets() };
+    auto const& arrays { level.get_planet_arrays() };
+
+    /* Flights: one independent simulation per release phase; those
+     * not finished when the budget runs out are flown again next time */
+    auto const horizon_ticks { static_cast<uint32_t>(LaunchSolver::param_flight_horizon / dt) };
+    auto const hold_ticks { static_cast<uint32_t>(LaunchSolver::param_capture_hold_time / dt) };
+
+    std::atomic<bool> found { false };
+    std::atomic<bool> out_of_budget { false };
+
+    assert(m_results.size() == m_releases.size() && m_evaluated.size() == m_releases.size());
+
+    size_t const first { m_evaluated_prefix };
+    ThreadPool.parallel_for(m_releases.size() - first, [&](size_t const begin, size_t const end)
+    {
+        for (size_t idx = first + begin; idx < first + end; ++idx)
+        {
+            /* The first one always finishes; every resume gets somewhere */
+            bool const can_stop { idx != first };
+
+            if (can_stop && (out_of_budget || (m_stop_at_first && found))) return;
+            if (m_evaluated[idx]) continue;
+
+            ShipState flight { m_releases[idx] };
+            Simulation::release(flight);
+
+            uint32_t stable_ticks { 0 };
+            for (uint32_t step = 0; step < horizon_ticks; ++step)
+            {
+                if (
+                    has_budget && can_stop && step % LaunchSolver::param_budget_check_interval == 0
+                    && Clock::now() > deadline
+                ) { out_of_budget = true; return; }
+
+                /* Early termination: collision or escape */
+                ShipEvent const event { Simulation::step(flight, dt, planets, arrays) };
+                if (event == ShipEvent::Collided || event == ShipEvent::Lost) break;
+
+                Orbit const& orbit { planets[flight.target].get_orbit() };
+                float const error { (flight.position - orbit.get_origin()).length() - orbit.get_radius() };
+                if (error > LaunchSolver::param_escape_distance) break;
+
+                stable_ticks = flight.stable ? stable_ticks + 1 : 0;
+                if (stable_ticks < hold_ticks) continue;
+
+                m_results[idx] = LaunchWindow {
+                    .release_time = static_cast<float>(m_release_ticks[idx]) * dt,
+                    .release_position = m_releases[idx].position,
+                    .target_planet = flight.target,
+                    .flight_time = static_cast<float>(step + 1) * dt,
+                };
+                found = true;
+                break;
+            }
+
+            m_evaluated[idx] = 1;
+        }
+    });
+
+    while (m_evaluated_prefix < m_evaluated.size() && m_evaluated[m_evaluated_prefix]) ++m_evaluated_prefix;
+}
+
+void LaunchSearch::collect()
+{
+    /* Only the evaluated prefix; a hole in the middle would read as a missing window */
+    m_solution.windows.clear();
+    for (size_t idx = 0; idx < m_evaluated_prefix; ++idx)
+        if (m_results[idx]) m_solution.windows.push_back(*m_results[idx]);
+
+    m_solution.candidates_evaluated = static_cast<uint32_t>(m_evaluated_prefix);
+    m_solution.complete = m_walked && m_evaluated_prefix == m_releases.size();
+
+    if (m_stop_at_first && m_walked && m_solution.windows.empty())
+    {
+        /* Any window will do; wherever it came from */
+        for (size_t idx = m_evaluated_prefix; idx < m_results.size(); ++idx)
+        {
+            if (!m_evaluated[idx] || !m_results[idx]) continue;
+            m_solution.windows.push_back(*m_results[idx]);
+            break;
+        }
+    }
+    if (m_stop_at_first && !m_solution.windows.empty()) m_solution.complete = true;
+}
+
+void LaunchSearch::rebase(sf::Vector2f const& shift)
+{
+    m_ship.position -= shift;
+    m_ship.previous_position -= shift;
+
+    for (auto& release : m_releases)
+    {
+        release.position -= shift;
+        release.previous_position -= shift;
+    }
+    for (auto& result : m_results)
+        if (result) result->release_position -= shift;
+    for (auto& window : m_solution.windows) window.release_position -= shift;
+}
+
+LaunchSolution LaunchSolver::solve(
+    Level const& level, ShipState const& start, float const dt,
+    uint32_t const candidate_count, float const budget_ms, bool const stop_at_first
+)
+{
+    LaunchSearch search;
+    search.start(start, level.get_planets()[start.target].get_orbit().get_radius(), dt, candidate_count, stop_at_first);
+    search.resume(level, dt, budget_ms);
+    return search.get_solution();
+}
+
+void LaunchSolver::start_playability_check()
+{
+    Level const& level { m_universe.get_level() };
+    if (level.get_planets().empty()) return;
+
+    m_playability_planet = 0;
+    m_playability_seed = level.get_seed();
+    m_playability_random = Xoshiro128{m_playability_seed};
+    m_playability_search.reset();
+    m_dead_ends.clear();
+}
+
+void LaunchSolver::update()
+{
+    update_hint();
+    update_playability();
+}
+
+void LaunchSolver::update_hint()
+{
+    if (!m_hint_enabled) return;
+
+    auto const& player { m_universe.get_player() };
+    if (!player.is(PlayerState::InStableOrbit))
+    {
+        m_solved_for = ShipState::npos;
+        m_search.reset();
+        m_markers.clear();
+        return;
+    }
+
+    Level const& level { m_universe.get_level() };
+    auto const& ctx { m_universe.get_navigation().get_context() };
+    auto const& planets { level.get_planets() };
+    auto const target_idx { static_cast<uint32_t>(&ctx.target_planet - planets.data()) };
+    float const dt { m_universe.get_delta_time() };
+
+    if (target_idx != m_solved_for)
+    {
+        ShipState const start {
+            .position = player.get_position(),
+            .previous_position = player.get_position() - player.get_velocity() * dt,
+            .target = target_idx,
+            .previous = target_idx,
+            .target_mass = ctx.target_planet.get_mass(),
+            .stable = true,
+        };
+
+        m_search.start(start, ctx.target_orbit.get_radius(), dt, param_candidate_count, false);
+        m_solved_for = target_idx;
+    }
+
+    /* Solved once per orbit; release points do not move */
+    if (m_search.is_complete()) return;
+
+    m_search.resume(level, dt, param_frame_budget_ms);
+    init_markers(ctx.target_orbit.get_origin());
+}
+
+void LaunchSolver::update_playability()
+{
+    if (!is_checking_playability()) return;
+
+    Level const& level { m_universe.get_level() };
+    auto const& planets { level.get_planets() };
+    if (level.get_seed() != m_playability_seed || m_playability_planet >= planets.size())
+    {
+        /* Level changed under it */
+        ORBIT_LOG(Warning, "core/launch") << "playability check cancelled; level changed";
+        m_playability_planet = ShipState::npos;
+        return;
+    }
+
+    float const dt { m_universe.get_delta_time() };
+    auto const deadline {
+        std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>{param_playability_budget_ms}
+        )
+    };
+
+    /* Planet by planet; within one tick's budget */
+    while (m_playability_planet < planets.size())
+    {
+        if (!m_playability_search.is_started())
+        {
+            Xoshiro128 random { m_playability_random };
+            m_playability_random.jump();
+
+            ShipState start;
+            Simulation::place_on_orbit(start, m_playability_planet, dt, planets, random);
+            m_playability_search.start(
+                start, planets[m_playability_planet].get_orbit().get_radius(), dt,
+                param_playability_candidate_count, true
+            );
+        }
+
+        std::chrono::duration<float, std::milli> const left { deadline - std::chrono::steady_clock::now() };
+        if (left.count() <= 0.0f) return;
+        if (!m_playability_search.resume(level, dt, left.count())) return;
+
+        if (m_playability_search.get_solution().windows.empty()) m_dead_ends.push_back(m_playability_planet);
+        m_playability_search.reset();
+        ++m_playability_planet;
+    }
+
+    ORBIT_LOG(Info, "core/launch")
+        << "playability: " << m_dead_ends.size() << "/" << planets.size()
+        << " planets have no launch window";
+    m_playability_planet = ShipState::npos;
+}
+
+void LaunchSolver::rebase(sf::Vector2f const& shift)
+{
+    carry(shift);
+    m_playability_search.rebase(shift);
+}
+
+void LaunchSolver::carry(sf::Vector2f const& shift)
+{
+    m_search.rebase(shift);
+    for (size_t idx = 0; idx < m_markers.getVertexCount(); ++idx) m_markers[idx].position -= shift;
+}
+
+void LaunchSolver::init_markers(sf::Vector2f const& origin)
+{
+    m_markers.clear();
+
+    for (auto const& window : m_search.get_solution().windows)
+    {
+        sf::Vector2f const radial { window.release_position - origin };
+        if (radial.lengthSquared() < 1.0f) continue;
+
+        /* Short radial tick across the orbit at the release point */
+        sf::Vector2f const half_marker { radial.normalized() * (param_visual_marker_length / 2.0f) };
+        m_markers.append({ .position = window.release_position - half_marker, .color = param_visual_marker_color });
+        m_markers.append({ .position = window.release_position + half_marker, .color = param_visual_marker_color });
+    }
+}
+
+void LaunchSolver::draw() const
+{
+    if (!m_hint_enabled) return;
+    Window.draw(m_markers);
+}
@@ -1,56 +1,443 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <tuple>
 #include "Core/Level.hpp"
+#include "Core/Log.hpp"
 #include "Core/Navigation.hpp"
+#include "Core/WorldOrigin.hpp"
 #include "Entity/Player.hpp"
 #include "Graphics/World.hpp"
 #include "Graphics/Color.hpp"
 #include "Math/Vector2.hpp"
 
-void Level::generate()
+LevelConfig LevelConfig::scaled_to(uint32_t const count) const
 {
+    LevelConfig scaled { *this };
+    scaled.planet_count = count;
+    scaled.extent_scaling_factor *= std::sqrt(static_cast<float>(count) / static_cast<float>(planet_count));
+    return scaled;
+}
+
+std::pair<ufd, ufd> Level::get_position_dist() const
+{
+    float const factor { m_config.extent_scaling_factor };
+    return {
+        ufd { -1920.f * factor, +1920.f * factor }, // x
+        ufd { -1080.f * factor, +1080.f * factor } // y
+    };
+}
+
+Level::~Level()
+{
+    if (m_generator.joinable()) m_generator.join();
+}
+
+void Level::generate(uint32_t const seed)
+{
+    finish_generate();
+    place(seed);
+}
+
+void Level::generate_async(uint32_t const seed)
+{
+    finish_generate();
+    m_generated.store(false, std::memory_order_relaxed);
+    m_placed_count.store(0, std::memory_order_relaxed);
+
+    m_generator = std::thread([this, seed]
+    {
+        place(seed);
+        m_generated.store(true, std::memory_order_release);
+    });
+}
+
+float Level::get_generate_progress() const
+{
+    if (is_generated()) return 1.0f;
+    return static_cast<float>(m_placed_count.load(std::memory_order_relaxed))
+           / static_cast<float>(std::max(m_config.planet_count, 1u));
+}
+
+void Level::finish_generate()
+{
+    if (m_generator.joinable()) m_generator.join();
+}
+
+void Level::clear()
+{
+    m_planets.clear();
+    m_motions.clear();
+    m_motion_tick = 0;
+    m_origin_cell = {}; /* Placed around the origin; see WorldOrigin::reset() */
+}
+
+void Level::place(uint32_t const seed)
+{
+    m_seed = seed;
+    m_random = Random{seed};
+
     /* Planet Generation */
-    m_planets.reserve(param_planet_count);
+    clear();
+    m_planets.reserve(m_config.planet_count);
 
     constexpr float v_target_sq { Player::param_target_orbital_velocity * Player::param_target_orbital_velocity };
+    constexpr float pi { 3.14159265f };
+
+    auto const position_dist { get_position_dist() };
+    sf::Vector2f const extent_min { position_dist.first.min(), position_dist.second.min() };
+    sf::Vector2f const extent_size {
+        position_dist.first.max() - extent_min.x,
+        position_dist.second.max() - extent_min.y
+    };
+
+    /* Moon lanes: a moon's periapsis clears whatever is further in
+     * (by the padding & its own orbit); the lane ends past its apoapsis */
+    bool const has_moons { m_config.moon_chance > 0.0f };
+    auto const next_lane {
+        [this](float const inner_reach, float const moon_orbit_radius, float const eccentricity)
+        {
+            float const periapsis { inner_reach + m_config.planet_padding + moon_orbit_radius };
+            float const semi_major_axis { periapsis / (1.0f - eccentricity) };
+            return std::pair { semi_major_axis, semi_major_axis * (1.0f + eccentricity) + moon_orbit_radius };
+        }
+    };
 
-    while (m_planets.size() < param_planet_count)
+    /* Overlap check only looks at the neighbouring cells of a uniform grid;
+     * a cell is at least as wide as the largest possible min_distance,
+     * so the result is the same as checking every planet */
+    float max_reach {
+        World::scale_distance(param_planet_determinant_dist.max() * param_orbit_radius_scaling_factor)
+    };
+    if (has_moons)
     {
-        sf::Vector2f const position { m_random.get(param_planet_position_dist) };
+        float const max_moon_orbit_radius {
+            World::scale_distance(param_moon_determinant_dist.max() * param_orbit_radius_scaling_factor)
+        };
+        for (uint32_t moon = 0; moon < param_max_moons; ++moon)
+            max_reach = next_lane(max_reach, max_moon_orbit_radius, param_moon_eccentricity_dist.max()).second;
+    }
+
+    float const cell_size {
+        std::max(
+            m_config.planet_padding + 2.0f * max_reach,
+            std::sqrt(extent_size.x * extent_size.y / static_cast<float>(4 * m_config.planet_count + 1)) // bounds the cell count
+        )
+    };
+    auto const columns { static_cast<int32_t>(extent_size.x / cell_size) + 1 };
+    auto const rows { static_cast<int32_t>(extent_size.y / cell_size) + 1 };
+    std::vector<std::vector<uint32_t>> grid(static_cast<size_t>(columns) * rows);
+    std::vector<float> reach; /* Per planet; orbit, or outermost moon lane */
+    reach.reserve(m_config.planet_count);
+
+    auto const cell_of {
+        [&](sf::Vector2f const& position)
+        {
+            return sf::Vector2i {
+                std::clamp(static_cast<int32_t>((position.x - extent_min.x) / cell_size), 0, columns - 1),
+                std::clamp(static_cast<int32_t>((position.y - extent_min.y) / cell_size), 0, rows - 1)
+            };
+        }
+    };
+
+    auto const overlaps_any {
+        [&](sf::Vector2f const& position, float const planet_reach, sf::Vector2i const& cell)
+        {
+            for (int32_t y = std::max(cell.y - 1, 0); y <= std::min(cell.y + 1, rows - 1); ++y)
+            for (int32_t x = std::max(cell.x - 1, 0); x <= std::min(cell.x + 1, columns - 1); ++x)
+            {
+                for (uint32_t const other_idx : grid[static_cast<size_t>(y) * columns + x])
+                {
+                    float const min_distance { m_config.planet_padding + planet_reach + reach[other_idx] };
+
+                    auto delta { position - m_planets[other_idx].get_position() };
+                    if (delta.length() < min_distance) return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    uint32_t rejections { 0 };
+    while (m_planets.size() < m_config.planet_count)
+    {
+        sf::Vector2f const position { m_random.get(position_dist) };
 
         float const dmt { m_random.get(param_planet_determinant_dist) };
         float const radius { World::scale_distance(dmt * param_planet_radius_scaling_factor) };
         float const orbit_radius { World::scale_distance(dmt * param_orbit_radius_scaling_factor) };
+        float const gravitational_parameter { v_target_sq * orbit_radius }; /* G * mass */
 
-        /* Check for overlap with existing planets */
-        bool overlap { false };
-        for (Planet const& other : m_planets)
+        /* Moons widen the space the planet needs */
+        std::array<float, param_max_moons> moon_dmts {};
+        std::array<KeplerOrbit, param_max_moons> moon_orbits {};
+        uint32_t moon_count { 0 };
+        float planet_reach { orbit_radius };
+
+        if (has_moons && m_random.get_unit<float>() < m_config.moon_chance)
         {
-            float const min_distance {
-                param_planet_padding + orbit_radius
-                + other.get_orbit().get_radius()
-            };
+            auto const room { static_cast<uint32_t>(m_config.planet_count - m_planets.size() - 1) };
+            moon_count = std::min(m_random.get(uid<uint32_t>{ 1, param_max_moons }), room);
+
+            for (uint32_t moon = 0; moon < moon_count; ++moon)
+            {
+                moon_dmts[moon] = m_random.get(param_moon_determinant_dist);
+                float const moon_orbit_radius {
+                    World::scale_distance(moon_dmts[moon] * param_orbit_radius_scaling_factor)
+                };
 
-            auto delta { position - other.get_position() };
-            overlap = delta.length() < min_distance;
-            if (overlap) break;
+                KeplerOrbit& orbit { moon_orbits[moon] };
+                orbit.eccentricity = m_random.get(param_moon_eccentricity_dist);
+                std::tie(orbit.semi_major_axis, planet_reach) = next_lane(planet_reach, moon_orbit_radius, orbit.eccentricity);
+                orbit.periapsis_angle = m_random.get(0.0f, 2.0f * pi);
+                orbit.mean_anomaly_at_epoch = m_random.get(0.0f, 2.0f * pi);
+                orbit.mean_motion =
+                    m_random.sign<float>() * param_moon_time_scale
+                    * KeplerOrbit::get_mean_motion(gravitational_parameter, orbit.semi_major_axis);
+            }
         }
 
-        if (overlap) continue;
+        /* Check for overlap with existing planets */
+        sf::Vector2i const cell { cell_of(position) };
+        bool const overlap { overlaps_any(position, planet_reach, cell) };
+
+        if (overlap)
+        {
+            if (++rejections < param_max_consecutive_rejections) continue;
+
+            ORBIT_LOG(Warning, "core/level")
+                << "level is full; placed " << m_planets.size()
+                << "/" << m_config.planet_count << " planets";
+            break;
+        }
+        rejections = 0;
 
         auto const orbit_color {
-            Color::get<Color::HWB>(
-                m_random.get(param_visual_orbit_color_hue_dist),
-                param_visual_orbit_color_whiteness,
-                param_visual_orbit_color_blackness
-           )
+            param_visual_orbit_palette.get(static_cast<float>(m_random.get(param_visual_orbit_color_hue_dist)))
         };
 
+        auto const planet_idx { static_cast<uint32_t>(m_planets.size()) };
+        grid[static_cast<size_t>(cell.y) * columns + cell.x].push_back(planet_idx);
+        reach.push_back(planet_reach);
+
         m_planets.emplace_back(
             position,
-            (v_target_sq * orbit_radius) / Navigation::G,
+            gravitational_parameter / Navigation::G,
             radius,
             param_visual_planet_color,
             orbit_radius,
             orbit_color
         );
+
+        /* Not in the grid; the parent's reach covers them */
+        for (uint32_t moon = 0; moon < moon_count; ++moon)
+        {
+            float const moon_radius { World::scale_distance(moon_dmts[moon] * param_planet_radius_scaling_factor) };
+            float const moon_orbit_radius { World::scale_distance(moon_dmts[moon] * param_orbit_radius_scaling_factor) };
+
+            m_motions.push_back({ static_cast<uint32_t>(m_planets.size()), planet_idx, moon_orbits[moon] });
+            reach.push_back(0.0f);
+
+            m_planets.emplace_back(
+                position + moon_orbits[moon].get_offset(0.0),
+                (v_target_sq * moon_orbit_radius) / Navigation::G,
+                moon_radius,
+                param_visual_planet_color,
+                moon_orbit_radius,
+                orbit_color
+            );
+        }
+
+        m_placed_count.store(static_cast<uint32_t>(m_planets.size()), std::memory_order_relaxed);
+    }
+
+    rebuild_planet_arrays();
+}
+
+void Level::rebuild_planet_arrays()
+{
+    m_planet_arrays.position.clear();
+    m_planet_arrays.radius.clear();
+    m_planet_arrays.visual_radius.clear();
+    m_planet_arrays.orbit_on.assign(m_planets.size(), 0);
+    m_displacement.clear();
+    m_displacement.resize(m_planets.size());
+    m_max_planet_radius = m_max_visual_radius = 0.0f;
+
+    m_absolute_positions.resize(m_planets.size());
+    m_moving.assign(m_planets.size(), 0);
+    for (PlanetMotion const& motion : m_motions)
+    {
+        assert(motion.planet < m_planets.size() && motion.parent < m_planets.size()); /* Left from another level; see clear() */
+        m_moving[motion.planet] = 1;
+    }
+
+    for (size_t idx = 0; idx < m_planets.size(); ++idx)
+    {
+        Planet& planet { m_planets[idx] };
+        m_absolute_positions[idx] = {
+            static_cast<double>(m_origin_cell.x) * WorldOrigin::param_cell_size + planet.get_position().x,
+            static_cast<double>(m_origin_cell.y) * WorldOrigin::param_cell_size + planet.get_position().y,
+        };
+        m_planet_arrays.position.push_back(planet.get_position());
+        m_planet_arrays.radius.push_back(planet.get_info().radius);
+        m_planet_arrays.visual_radius.push_back(planet.get_orbit().get_visual_radius());
+        planet.get_orbit().bind_state_mirror(&m_planet_arrays.orbit_on[idx]);
+        planet.detach_drawable();
+
+        m_max_planet_radius = std::max(m_max_planet_radius, planet.get_info().radius);
+        m_max_visual_radius = std::max(m_max_visual_radius, planet.get_orbit().get_visual_radius());
     }
+
+    build_index();
+
+    /* Planets that were removed cannot give theirs back */
+    m_drawable_pool.release_all();
+    m_visible.clear();
+    m_drawn.clear();
+    m_last_visible_frame.assign(m_planets.size(), 0);
+}
+
+void Level::build_index()
+{
+    if (m_planets.empty()) return m_index.clear();
+
+    /* Everywhere a planet can be; moons anywhere out to their apoapsis */
+    sf::Vector2f min { m_planets.front().get_position() };
+    sf::Vector2f max { min };
+    auto const include { [&min, &max](sf::Vector2f const& point, float const margin)
+    {
+        min = { std::min(min.x, point.x - margin), std::min(min.y, point.y - margin) };
+        max = { std::max(max.x, point.x + margin), std::max(max.y, point.y + margin) };
+    } };
+
+    for (Planet const& planet : m_planets) include(planet.get_position(), 0.0f);
+    for (PlanetMotion const& motion : m_motions)
+        include(m_planets[motion.parent].get_position(), motion.orbit.get_apoapsis());
+
+    /* Cells about as wide as a planet's rings, fewer than param_index_cells_per_planet each */
+    float const area { (max.x - min.x) * (max.y - min.y) };
+    float const cell_size {
+        std::max({
+            2.0f * m_max_visual_radius,
+            std::sqrt(area / static_cast<float>(param_index_cells_per_planet * m_planets.size())),
+            1.0f
+        })
+    };
+    m_index.build(m_planet_arrays.position.span(), min, max, cell_size);
+}
+
+void Level::advance_motion(float const dt)
+{
+    if (!has_motion()) return;
+    ++m_motion_tick;
+    update_motion(dt);
+}
+
+void Level::set_motion_tick(uint32_t const tick, float const dt)
+{
+    m_motion_tick = tick;
+    if (!has_motion()) return;
+
+    update_motion(dt);
+    for (PlanetMotion const& motion : m_motions) m_displacement.set(motion.planet, {}); /* A jump; nothing carried */
+}
+
+void Level::update_motion(float const dt)
+{
+    double const time { static_cast<double>(m_motion_tick) * static_cast<double>(dt) };
+
+    /* Parents hold still; their (rebased) position is current */
+    for (PlanetMotion const& motion : m_motions)
+    {
+        Planet& planet { m_planets[motion.planet] };
+        sf::Vector2f const position { m_planets[motion.parent].get_position() + motion.orbit.get_offset(time) };
+
+        m_displacement.set(motion.planet, position - planet.get_position());
+        planet.set_position(position);
+        m_planet_arrays.position.set(motion.planet, position);
+        m_index.move(motion.planet, position);
+    }
+}
+
+void Level::update_drawables(sf::View const& view)
+{
+    ++m_frame;
+    m_visible.clear();
+
+    sf::Vector2f const half_size { view.getSize() / 2.0f };
+    sf::Vector2f const min { view.getCenter() - half_size };
+    sf::Vector2f const max { view.getCenter() + half_size };
+    sf::Vector2f const reach { m_max_visual_radius, m_max_visual_radius };
+
+    auto const& [position, radius, orbit_on, visual_radius] { m_planet_arrays };
+    m_index.any_in(min - reach, max + reach, [&](uint32_t const idx)
+    {
+        /* Circle vs. rectangle */
+        float const x { position.x[idx] };
+        float const y { position.y[idx] };
+        float const dx { std::max({ min.x - x, 0.0f, x - max.x }) };
+        float const dy { std::max({ min.y - y, 0.0f, y - max.y }) };
+        if (dx * dx + dy * dy >= visual_radius[idx] * visual_radius[idx]) return false;
+
+        m_visible.push_back(idx);
+        m_last_visible_frame[idx] = m_frame;
+
+        Planet& planet { m_planets[idx] };
+        if (planet.has_drawable()) return false;
+
+        planet.attach_drawable(m_drawable_pool.acquire());
+        m_drawn.push_back(idx);
+        return false;
+    });
+
+    /* Cells come in grid order; draw in planet order, as before */
+    std::sort(m_visible.begin(), m_visible.end());
+
+    for (size_t drawn_idx = 0; drawn_idx < m_drawn.size();)
+    {
+        uint32_t const idx { m_drawn[drawn_idx] };
+        if (m_frame - m_last_visible_frame[idx] <= param_drawable_release_frames) { ++drawn_idx; continue; }
+
+        m_drawable_pool.release(*m_planets[idx].detach_drawable());
+        m_drawn[drawn_idx] = m_drawn.back();
+        m_drawn.pop_back();
+    }
+}
+
+void Level::draw() const
+{
+    for (uint32_t const idx : m_visible) m_planets[idx].draw();
+}
+
+void Level::print_drawables() const
+{
+    ORBIT_LOG(Info, "graphics/drawables")
+        << m_visible.size() << " planets visible, " << m_drawable_pool.get_used_count()
+        << " drawables in use (" << m_drawable_pool.get_size() << " pooled) for " << m_planets.size() << " planets";
+}
+
+void Level::rebase(sf::Vector2f const& shift, sf::Vector2i const& cell)
+{
+    m_origin_cell = cell;
+    sf::Vector2<double> const origin {
+        static_cast<double>(cell.x) * WorldOrigin::param_cell_size,
+        static_cast<double>(cell.y) * WorldOrigin::param_cell_size,
+    };
+
+    for (size_t idx = 0; idx < m_planets.size(); ++idx)
+    {
+        /* One rounding from the absolute place; never piles up */
+        if (m_moving[idx]) m_planets[idx].rebase(shift);
+        else m_planets[idx].set_position({
+            static_cast<float>(m_absolute_positions[idx].x - origin.x),
+            static_cast<float>(m_absolute_positions[idx].y - origin.y),
+        });
+        m_planet_arrays.position.set(idx, m_planets[idx].get_position());
+    }
+
+    m_index.rebase(shift);
+    for (size_t idx = 0; idx < m_planets.size(); ++idx) /* Not quite `- shift`; a point on a cell border may cross it */
+        m_index.move(static_cast<uint32_t>(idx), m_planets[idx].get_position());
 }
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "Core/Log.hpp"
+
+Log::Log()
+    : m_thread{[this] { run(); }} {}
+
+Log::~Log()
+{
+    {
+        std::lock_guard const lock { m_mutex };
+        m_running = false;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+
+    drain(); // anything logged while stopping
+    std::cout.flush();
+}
+
+LogRing& Log::get_thread_ring()
+{
+    thread_local LogRing* ring { nullptr };
+    if (ring) return *ring;
+
+    std::lock_guard const lock { m_mutex };
+    ring = m_rings.emplace_back(std::make_unique<LogRing>()).get();
+    return *ring;
+}
+
+void Log::flush()
+{
+    std::unique_lock lock { m_mutex };
+    uint64_t const request { ++m_flush_requests };
+    m_wakeup.notify_one();
+    m_flushed.wait(lock, [&] { return m_flushes_done >= request || !m_running; });
+}
+
+void Log::run()
+{
+    std::unique_lock lock { m_mutex };
+    while (m_running)
+    {
+        m_wakeup.wait_for(lock, param_flush_interval);
+
+        uint64_t const requests { m_flush_requests };
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        m_flushes_done = requests;
+        m_flushed.notify_all();
+    }
+}
+
+void Log::drain()
+{
+    /* Rings are never removed; only the list may grow meanwhile */
+    std::vector<LogRing*> rings;
+    {
+        std::lock_guard const lock { m_mutex };
+        rings.reserve(m_rings.size());
+        for (auto const& ring : m_rings) rings.push_back(ring.get());
+    }
+
+    bool written { false };
+    for (LogRing* const ring : rings)
+    {
+        written |= ring->drain(write) > 0;
+
+        if (uint64_t const dropped { ring->take_dropped() })
+        {
+            std::cout << "[core/log] [warning] ring full; dropped " << dropped << " lines\n";
+            written = true;
+        }
+    }
+
+    if (written) std::cout.flush();
+}
+
+void Log::write(LogRecord const& record)
+{
+    std::cout << '[' << record.tag << "] ";
+    switch (record.level)
+    {
+    case LogLevel::Debug: std::cout << "[debug] "; break;
+    case LogLevel::Warning: std::cout << "[warning] "; break;
+    case LogLevel::Error: std::cout << "[error] "; break;
+    case LogLevel::Info: break;
+    }
+
+    std::cout.write(record.text.data(), record.length);
+    if (record.suppressed) std::cout << " (" << record.suppressed << " similar suppressed)";
+    std::cout << '\n';
+}
+
+LogLine::LogLine(LogLevel const level, char const* const tag, uint32_t const suppressed)
+    : m_ring{&Log.get_thread_ring()}
+{
+    m_record = m_ring->try_acquire();
+    if (!m_record) return;
+
+    m_record->tag = tag;
+    m_record->level = level;
+    m_record->suppressed = suppressed;
+    m_record->length = 0;
+}
+
+LogLine::~LogLine()
+{
+    if (m_record) m_ring->commit();
+}
+
+LogLine& LogLine::operator<<(std::string_view const text)
+{
+    if (!m_record) return *this;
+
+    size_t const available { LogRecord::param_text_capacity - m_record->length };
+    size_t const count { std::min(available, text.size()) };
+    std::memcpy(m_record->text.data() + m_record->length, text.data(), count);
+    m_record->length += static_cast<uint16_t>(count);
+    return *this;
+}
+
+LogLine& LogLine::write_signed(int64_t const value)
+{
+    char buffer[24];
+    auto const result { std::to_chars(std::begin(buffer), std::end(buffer), value) };
+    return *this << std::string_view{buffer, static_cast<size_t>(result.ptr - buffer)};
+}
+
+LogLine& LogLine::write_unsigned(uint64_t const value)
+{
+    char buffer[24];
+    auto const result { std::to_chars(std::begin(buffer), std::end(buffer), value) };
+    return *this << std::string_view{buffer, static_cast<size_t>(result.ptr - buffer)};
+}
+
+LogLine& LogLine::operator<<(double const value)
+{
+    /* Same as std::ostream's default (%g, 6 significant digits) */
+    char buffer[32];
+    int const length { std::snprintf(buffer, sizeof(buffer), "%g", value) };
+    return *this << std::string_view{buffer, static_cast<size_t>(std::max(length, 0))};
+}
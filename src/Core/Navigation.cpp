@@ -1,6 +1,8 @@
+#include <cmath>
 #include <functional>
 #include "Core/Navigation.hpp"
 #include "Core/Level.hpp"
+#include "Core/Universe.hpp"
 #include "Entity/Player.hpp"
 
 template <typename T>
@@ -15,33 +17,31 @@ using NullableRef = std::optional<std::reference_wrapper<T>>;
  * Anyway, this method should only be called *after*
  * the player is created and the level is generated.
  */
-NavigationContext Navigation::make_context() const
+NavigationContext Navigation::make_context(Planet* const restored_previous_planet) const
 {
-    assert (m_player);
+    Level& level { m_universe.get_level() };
+    auto& planets { level.get_planets() };
+    auto const& arrays { level.get_planet_arrays() };
+    Vector2ConstSpan const positions { arrays.position.span() };
+    sf::Vector2f const player_position { m_universe.get_player().get_position() };
 
     float player_error { -1 };
-    float min_distance_orbit_unchecked { -1 };
-    float min_distance_orbit_checked { -1 };
-
 
     NullableRef<Planet> candidate_nearest; /* Candidate for nearest planet */
     NullableRef<Planet> candidate_target; /* Candidate for target planet */
 
-    for (Planet& planet : Level.get_planets())
-    {
-        float const current_distance { m_player->get_distance(planet.get_position()) };
-        if (min_distance_orbit_unchecked < 0.0f || current_distance < min_distance_orbit_unchecked)
-        {
-            min_distance_orbit_unchecked = current_distance;
-            candidate_nearest.emplace(planet);
-        }
+    /* Through the level's index; only the cells around the player are looked at */
+    SpatialIndex const& index { level.get_index() };
 
-        if (auto const& orbit = planet.get_orbit(); orbit.is_on()) {
-            if (min_distance_orbit_checked > 0.0f && current_distance > min_distance_orbit_checked) continue;
-            min_distance_orbit_checked = current_distance;
-            player_error = current_distance - orbit.get_radius();
-            candidate_target.emplace(planet);
-        }
+    if (auto const nearest = index.nearest(positions, player_position); nearest.index != Vector2Batch::npos)
+        candidate_nearest.emplace(planets[nearest.index]);
+
+    if (auto const target = index.nearest(positions, player_position, arrays.orbit_on.data());
+        target.index != Vector2Batch::npos)
+    {
+        Planet& planet { planets[target.index] };
+        player_error = std::sqrt(target.distance_squared) - planet.get_orbit().get_radius();
+        candidate_target.emplace(planet);
     }
 
     assert (
@@ -53,18 +53,24 @@ NavigationContext Navigation::make_context() const
     Planet& ref_nearest { candidate_nearest->get() };
     Planet& ref_target { candidate_target->get() };
 
-    /* We still need to do some work to find the previous planet */
-    Planet& ref_prev { ctx_get_previous_planet(ref_target) };
+    /* We still need to do some work to find the previous planet;
+     * unless restoring, where the current context is no history */
+    Planet& ref_prev {
+        (restored_previous_planet)
+        ? *restored_previous_planet
+        : ctx_get_previous_planet(ref_target)
+    };
 
     /* Player's relative velocity components */
     auto const& [v_radial, v_tangent] {
-        ctx_get_velocity_components()
+        ctx_get_velocity_components(ref_target, restored_previous_planet != nullptr)
     };
 
     return {
     .player_radial_v = v_radial,
     .player_tangent_v = v_tangent,
     .player_error = player_error,
+    .player_state = Player::classify(player_error, v_radial),
     .target_planet = ref_target,
     .target_orbit = ref_target.get_orbit(),
     .nearest_planet = ref_nearest,
@@ -74,15 +80,18 @@ NavigationContext Navigation::make_context() const
     };
 }
 
-std::pair<sf::Vector2f, sf::Vector2f> Navigation::ctx_get_velocity_components() const
+std::pair<sf::Vector2f, sf::Vector2f> Navigation::ctx_get_velocity_components(Planet const& target, bool const is_restoring) const
 {
-    /* Context is NULL => game just started => velocity = NULL */
-    if (!has_context()) return {}; // default construct NULL vectors
+    /* Context is NULL => game just started => velocity = NULL; a restore is mid game */
+    if (!has_context() && !is_restoring) return {}; // default construct NULL vectors
+
+    Player const& player { m_universe.get_player() };
+    sf::Vector2f const& origin { target.get_orbit().get_origin() };
 
-    sf::Vector2f v_radial = m_player->get_radial_velocity_vector();
+    sf::Vector2f v_radial = player.get_radial_velocity_vector(origin);
     if (v_radial.length() < 1.0f) v_radial *= 0.0f;
 
-    sf::Vector2f v_tangent = m_player->get_tangential_velocity_vector();
+    sf::Vector2f v_tangent = player.get_tangential_velocity_vector(origin);
     if (v_tangent.length() < 1.0f) v_tangent *= 0.0f;
 
     return { v_radial, v_tangent };
@@ -95,23 +104,77 @@ Planet& Navigation::ctx_get_previous_planet(Planet& current_target_ref) const
 
     if (
         &m_context->target_planet != &current_target_ref /* Target planet has changed */
-        && m_player->is(PlayerState::InStableOrbit) /* Player was stable in orbit */
+        && m_universe.get_player().is(PlayerState::InStableOrbit) /* Player was stable in orbit */
     )  return m_context->target_planet; /* Update previous planet; allowing player to respawn there */
 
     return m_context->previous_planet; /* Otherwise previous planet remains unchanged; player will respawn further back */
 }
 
+void Navigation::restore_context(Planet& previous_planet)
+{
+    m_context.emplace(make_context(&previous_planet));
+}
+
 void Navigation::draw() const { /* Nothing as of now */ }
 
 void Navigation::update()
 {
-    if (!m_player) m_player = &Game.get_player();
     force_reload(); /* Reload context once every frame */
+    publish_transitions();
+}
+
+void Navigation::publish(NavigationEvent const& event) const
+{
+    for (auto const& listener : m_listeners) listener(event);
+}
+
+void Navigation::publish_transitions()
+{
+    auto const& ctx { get_context() };
+
+    if (&ctx.target_planet != m_published_target)
+    {
+        publish({ NavigationEventType::TargetChanged, &ctx.target_planet, m_published_target });
+        m_published_target = &ctx.target_planet;
+    }
+
+    if (&ctx.previous_planet != m_published_previous)
+    {
+        publish({ NavigationEventType::PreviousChanged, &ctx.previous_planet });
+        m_published_previous = &ctx.previous_planet;
+    }
+
+    PlayerStateMask const changed { ctx.player_state ^ m_previous_player_state };
+    auto const transition {
+        [&](PlayerState const state, NavigationEventType const risen, NavigationEventType const fallen)
+        {
+            PlayerStateMask const bit { player_state_mask(state) };
+            if (!(changed & bit)) return;
+            publish({ (ctx.player_state & bit) ? risen : fallen, &ctx.target_planet });
+        }
+    };
+
+    transition(PlayerState::InsideSmoothingRing, NavigationEventType::EnteredSmoothingRing, NavigationEventType::LeftSmoothingRing);
+    transition(PlayerState::FarOutsideOrbit, NavigationEventType::EnteredFarOutside, NavigationEventType::LeftFarOutside);
+
+    if (changed & ctx.player_state & player_state_mask(PlayerState::InStableOrbit))
+        publish({ NavigationEventType::Captured, &ctx.target_planet });
+
+    if (changed & m_previous_player_state & player_state_mask(PlayerState::SomewhereInsideOrbit))
+        publish({ NavigationEventType::Escaped, &ctx.target_planet });
+
+    m_previous_player_state = ctx.player_state;
+}
+
+void Navigation::on_player_exploded()
+{
+    Planet* const target { has_context() ? &m_context->target_planet : nullptr };
+    publish({ NavigationEventType::Exploded, target });
 }
 
 void Navigation::release_player_from_orbit()
 {
-    for (auto& planet : Level.get_planets()) planet.get_orbit().turn_on(); // turn on everything else
+    for (auto& planet : m_universe.get_level().get_planets()) planet.get_orbit().turn_on(); // turn on everything else
     get_context().target_orbit.turn_off(); // turn off active planet's orbit
     return force_reload();
 }
@@ -0,0 +1,207 @@
+#include <cmath>
+#include "Core/Prediction.hpp"
+#include "Core/Assist.hpp"
+#include "Core/Level.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/Simulation.hpp"
+#include "Core/Universe.hpp"
+#include "Entity/Player.hpp"
+#include "Graphics/Window.hpp"
+#include "Math/Vector2.hpp"
+
+void Prediction::clear()
+{
+    m_steps.clear();
+    m_path.clear();
+    m_terminated = false;
+}
+
+void Prediction::rebase(sf::Vector2f const& shift)
+{
+    for (auto& step : m_steps)
+    {
+        step.position -= shift;
+        step.previous_position -= shift;
+    }
+    rebuild_path();
+}
+
+void Prediction::draw() const
+{
+    Window.draw(m_path);
+}
+
+void Prediction::update()
+{
+    auto const& player { m_universe.get_player() };
+    if (player.is(PlayerState::Exploding)) return clear();
+
+    /* While the player sits in a stable orbit, preview what
+     * happens on release: their orbit OFF, everything else ON */
+    auto const& ctx { m_universe.get_navigation().get_context() };
+    Planet const* excluded {
+        player.is(PlayerState::InStableOrbit)
+        ? &ctx.target_planet
+        : nullptr
+    };
+
+    if (excluded != m_excluded)
+    {
+        m_excluded = excluded;
+        m_preview_turn = 0.0f;
+        truncate_at_first_divergence();
+    }
+
+    if (m_excluded && carry_release_preview())
+    {
+        /* Turned steps are kept while the same planet pulls them; from the
+         * first one another planet would pull, simulated anew */
+        truncate_at_first_divergence();
+        extend();
+        return rebuild_path();
+    }
+
+    /* The player advanced by one tick; consume the
+     * matching step if the prediction still holds */
+    if (
+        m_steps.size() > 1
+        && (m_steps[1].position - player.get_position()).length()
+           <= param_prediction_divergence_tolerance
+    ) m_steps.pop_front();
+    else
+    {
+        /* Inputs changed (release, respawn, assist correction...);
+         * nothing in the cache can be trusted anymore */
+        clear();
+        m_preview_turn = 0.0f;
+        m_steps.push_back({
+            .position = player.get_position(),
+            .previous_position = player.get_position() - player.get_velocity() * m_universe.get_delta_time(),
+        });
+    }
+
+    extend();
+    rebuild_path();
+}
+
+bool Prediction::carry_release_preview()
+{
+    if (m_steps.empty() || m_preview_turn >= param_release_preview_refresh_angle) return false;
+
+    auto const& player { m_universe.get_player() };
+    sf::Vector2f const origin { m_excluded->get_position() };
+    sf::Vector2f const from { m_steps.front().position - origin };
+    sf::Vector2f const to { player.get_position() - origin };
+    if (from.lengthSquared() < 1.0f || std::abs(to.length() - from.length()) > param_prediction_divergence_tolerance)
+        return false; /* Pushed off the circle (e.g. by Assist); re-simulate */
+
+    /* One tick further round the orbit; same path, turned with it */
+    float const angle { std::atan2(from.cross(to), from.dot(to)) };
+    float const cos_angle { std::cos(angle) };
+    float const sin_angle { std::sin(angle) };
+    auto const turn { [&](sf::Vector2f const& position)
+    {
+        sf::Vector2f const offset { position - origin };
+        return origin + sf::Vector2f{
+            offset.x * cos_angle - offset.y * sin_angle,
+            offset.x * sin_angle + offset.y * cos_angle
+        };
+    } };
+
+    sf::Vector2f const player_previous_position {
+        player.get_position() - player.get_velocity() * m_universe.get_delta_time()
+    };
+    if ((turn(m_steps.front().previous_position) - player_previous_position).length() > param_prediction_divergence_tolerance)
+        return false; /* Velocity changed (e.g. inverted) */
+
+    for (auto& step : m_steps)
+    {
+        step.position = turn(step.position);
+        step.previous_position = turn(step.previous_position);
+    }
+
+    m_preview_turn += std::abs(angle);
+    return true;
+}
+
+Planet const* Prediction::find_puller(sf::Vector2f const& position) const
+{
+    Level const& level { m_universe.get_level() };
+    auto const& planets { level.get_planets() };
+    auto const& arrays { level.get_planet_arrays() };
+    Vector2ConstSpan const positions { arrays.position.span() };
+
+    uint32_t const collided {
+        Vector2Batch::first_within(positions, arrays.radius.data(), param_prediction_collision_padding, position)
+    };
+    if (collided != Vector2Batch::npos) return nullptr;
+
+    /* Excluded => every orbit but that one is ON */
+    uint32_t const puller {
+        (m_excluded)
+        ? Vector2Batch::nearest(positions, position, nullptr, static_cast<uint32_t>(m_excluded - planets.data())).index
+        : Vector2Batch::nearest(positions, position, arrays.orbit_on.data()).index
+    };
+
+    return (puller != Vector2Batch::npos) ? &planets[puller] : nullptr;
+}
+
+void Prediction::truncate_at_first_divergence()
+{
+    for (size_t idx = 0; idx + 1 < m_steps.size(); ++idx)
+    {
+        if (find_puller(m_steps[idx].position) == m_steps[idx].puller) continue;
+
+        /* Steps up to (and including) idx are still valid;
+         * only the motion after it depends on the changed orbits */
+        m_steps.erase(m_steps.begin() + static_cast<std::ptrdiff_t>(idx) + 1, m_steps.end());
+        m_steps.back().puller = nullptr;
+        m_terminated = false;
+        return;
+    }
+}
+
+void Prediction::extend()
+{
+    float const dt { m_universe.get_delta_time() };
+    float const far_outside_distance {
+        Player::param_orbit_far_distance_factor
+        * Assist::param_assist_radial_smoothing_ring_region_size.second
+    };
+
+    while (!m_terminated && m_steps.size() < param_prediction_step_count)
+    {
+        PredictionStep& last { m_steps.back() };
+
+        Planet const* puller { find_puller(last.position) };
+        if (!puller) { m_terminated = true; break; }
+        last.puller = puller;
+
+        /* Same motion as the player's; see Simulation::advance() */
+        PredictionStep next { .position = last.position, .previous_position = last.previous_position };
+        float const error { (last.position - puller->get_position()).length() - puller->get_orbit().get_radius() };
+
+        Simulation::advance(
+            next.position, next.previous_position,
+            puller->get_position(), puller->get_mass(), error > far_outside_distance, dt
+        );
+        m_steps.push_back(next);
+    }
+}
+
+void Prediction::rebuild_path()
+{
+    m_path.resize(m_steps.size());
+
+    for (size_t idx = 0; idx < m_steps.size(); ++idx)
+    {
+        /* Fade out towards the end of the prediction */
+        float const ratio { 1.0f - static_cast<float>(idx) / static_cast<float>(param_prediction_step_count) };
+
+        sf::Color color { param_visual_path_color };
+        color.a = static_cast<uint8_t>(param_visual_path_alpha * ratio);
+
+        m_path[idx].position = m_steps[idx].position;
+        m_path[idx].color = color;
+    }
+}
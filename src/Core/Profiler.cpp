@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdio>
+#include "Core/Log.hpp"
+#include "Core/Profiler.hpp"
+#include "Graphics/Overlay.hpp"
+#include "Graphics/Window.hpp"
+
+void Profiler::end_frame()
+{
+    /* Tasks of this frame have all finished; nothing records meanwhile */
+    for (size_t idx = 0; idx < scope_count; ++idx)
+        m_history[m_frame][idx] = static_cast<float>(m_current[idx].exchange(0, std::memory_order_relaxed)) / 1000.0f;
+
+    m_frame = (m_frame + 1) % param_frame_history;
+    m_frames_recorded = std::min<size_t>(m_frames_recorded + 1, param_frame_history);
+
+    if (m_overlay_enabled) rebuild_overlay();
+}
+
+float Profiler::get_average(ProfileScope const scope) const
+{
+    if (m_frames_recorded == 0) return 0.0f;
+
+    float sum { 0.0f };
+    for (size_t frame = 0; frame < m_frames_recorded; ++frame)
+        sum += m_history[frame][static_cast<size_t>(scope)];
+
+    return sum / static_cast<float>(m_frames_recorded);
+}
+
+float Profiler::get_max(ProfileScope const scope) const
+{
+    float max { 0.0f };
+    for (size_t frame = 0; frame < m_frames_recorded; ++frame)
+        max = std::max(max, m_history[frame][static_cast<size_t>(scope)]);
+
+    return max;
+}
+
+void Profiler::print() const
+{
+    ORBIT_LOG(Info, "core/profiler") << "last " << m_frames_recorded << " frames (avg / max, us):";
+    for (size_t idx = 0; idx < scope_count; ++idx)
+    {
+        auto const scope { static_cast<ProfileScope>(idx) };
+
+        char row[64];
+        std::snprintf(row, sizeof(row), "  %-14s%10.1f / %10.1f",
+            profile_scope_names[idx], get_average(scope), get_max(scope));
+        ORBIT_LOG(Info, "core/profiler") << row;
+    }
+}
+
+void Profiler::rebuild_overlay()
+{
+    m_overlay.clear();
+
+    float const frame_budget_us { 1e6f * Window.get_delta_time() };
+    sf::Vector2f const origin { param_visual_overlay_origin };
+
+    /* Panel 1: stacked per-scope time of each frame in the history (oldest -> newest) */
+    float const graph_width { param_visual_graph_column_width * param_frame_history };
+    Overlay::append_rect(m_overlay, origin, {graph_width, param_visual_graph_height}, param_visual_background_color);
+
+    for (size_t column = 0; column < param_frame_history; ++column)
+    {
+        auto const& frame { m_history[(m_frame + column) % param_frame_history] };
+        float const x { origin.x + static_cast<float>(column) * param_visual_graph_column_width };
+        float y { origin.y + param_visual_graph_height };
+
+        for (size_t idx = 0; idx < scope_count; ++idx)
+        {
+            if (static_cast<ProfileScope>(idx) == ProfileScope::Collision) continue; // nested; already in Player
+
+            float const height { std::min(frame[idx] / frame_budget_us * param_visual_graph_height, y - origin.y) };
+            if (height <= 0.0f) continue;
+
+            y -= height;
+            Overlay::append_rect(m_overlay, {x, y}, {param_visual_graph_column_width, height}, scope_colors[idx]);
+        }
+    }
+
+    /* Panel 2: rolling average (bar) & maximum (tick) per scope */
+    sf::Vector2f const bars_origin { origin.x + graph_width + param_visual_panel_spacing, origin.y };
+    float const bars_height { param_visual_bar_row_height * scope_count };
+    Overlay::append_rect(m_overlay, bars_origin, {param_visual_bar_max_width, bars_height}, param_visual_background_color);
+
+    for (size_t idx = 0; idx < scope_count; ++idx)
+    {
+        auto const scope { static_cast<ProfileScope>(idx) };
+        float const y { bars_origin.y + static_cast<float>(idx) * param_visual_bar_row_height };
+        float const scale { param_visual_bar_max_width / frame_budget_us };
+
+        float const average_width { std::min(get_average(scope) * scale, param_visual_bar_max_width) };
+        float const max_x { std::min(get_max(scope) * scale, param_visual_bar_max_width) };
+
+        Overlay::append_rect(m_overlay, {bars_origin.x, y + 2.0f}, {average_width, param_visual_bar_row_height - 4.0f}, scope_colors[idx]);
+        Overlay::append_rect(m_overlay, {bars_origin.x + max_x, y}, {2.0f, param_visual_bar_row_height}, scope_colors[idx]);
+    }
+
+    /* Frame budget markers */
+    Overlay::append_rect(m_overlay, origin, {graph_width, 2.0f}, param_visual_budget_color);
+    Overlay::append_rect(m_overlay, {bars_origin.x + param_visual_bar_max_width, bars_origin.y}, {2.0f, bars_height}, param_visual_budget_color);
+}
+
+void Profiler::draw() const
+{
+    if (!m_overlay_enabled) return;
+    Window.draw_overlay(m_overlay);
+}
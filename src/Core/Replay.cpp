@@ -0,0 +1,219 @@
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include "Core/Replay.hpp"
+#include "Core/Log.hpp"
+
+/* Little endian binary helpers */
+namespace
+{
+    void write_u8(std::ostream& out, uint8_t const value) { out.put(static_cast<char>(value)); }
+
+    void write_u16(std::ostream& out, uint16_t const value)
+    {
+        write_u8(out, value & 0xff);
+        write_u8(out, value >> 8);
+    }
+
+    void write_u32(std::ostream& out, uint32_t const value)
+    {
+        write_u16(out, value & 0xffff);
+        write_u16(out, value >> 16);
+    }
+
+    void write_f32(std::ostream& out, float const value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        write_u32(out, bits);
+    }
+
+    void write_varint(std::ostream& out, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            write_u8(out, static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        write_u8(out, static_cast<uint8_t>(value));
+    }
+
+    uint8_t read_u8(std::istream& in) { return static_cast<uint8_t>(in.get()); }
+
+    uint16_t read_u16(std::istream& in)
+    {
+        uint16_t const low { read_u8(in) };
+        return low | static_cast<uint16_t>(read_u8(in) << 8);
+    }
+
+    uint32_t read_u32(std::istream& in)
+    {
+        uint32_t const low { read_u16(in) };
+        return low | static_cast<uint32_t>(read_u16(in)) << 16;
+    }
+
+    float read_f32(std::istream& in)
+    {
+        uint32_t const bits { read_u32(in) };
+        float value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+
+    uint32_t read_varint(std::istream& in)
+    {
+        uint32_t value { 0 };
+        for (uint32_t shift = 0; shift < 32; shift += 7)
+        {
+            uint8_t const byte { read_u8(in) };
+            value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    }
+}
+
+void Replay::start_recording(
+    std::filesystem::path const& path, ReplaySeeds const& seeds,
+    LevelConfig const& level_config, uint32_t const tick_rate
+)
+{
+    m_recording = true;
+    m_playing = false;
+    m_path = path;
+    m_seeds = seeds;
+    m_level_config = level_config;
+    m_tick_rate = tick_rate;
+    m_inputs.clear();
+}
+
+void Replay::record(ReplayInput const& input)
+{
+    if (!m_recording) return;
+    assert(m_inputs.empty() || m_inputs.back().tick <= input.tick);
+    m_inputs.push_back(input);
+}
+
+bool Replay::stop_recording(uint32_t const final_tick)
+{
+    if (!m_recording) return false;
+    m_recording = false;
+    m_final_tick = final_tick;
+
+    std::ofstream out { m_path, std::ios::binary };
+    if (!out)
+    {
+        ORBIT_LOG(Error, "core/replay") << "cannot write: " << m_path;
+        return false;
+    }
+
+    write_u32(out, param_file_magic);
+    write_u16(out, param_file_version);
+    write_u32(out, m_tick_rate);
+    write_u32(out, m_final_tick);
+    write_u32(out, m_seeds.level);
+    write_u32(out, m_seeds.player);
+    write_u32(out, m_seeds.particles);
+    write_u32(out, m_level_config.planet_count);
+    write_f32(out, m_level_config.extent_scaling_factor);
+    write_f32(out, m_level_config.planet_padding);
+    write_f32(out, m_level_config.moon_chance);
+
+    uint32_t previous_tick { 0 };
+    for (auto const& input : m_inputs)
+    {
+        write_varint(out, input.tick - previous_tick);
+        previous_tick = input.tick;
+
+        write_u8(out, static_cast<uint8_t>(input.type));
+        switch (input.type)
+        {
+        case ReplayInputType::KeyPressed: write_u8(out, static_cast<uint8_t>(input.key)); break;
+        case ReplayInputType::MouseSeek: write_f32(out, input.position.x); write_f32(out, input.position.y); break;
+        case ReplayInputType::MouseClick: break;
+        }
+    }
+
+    ORBIT_LOG(Info, "core/replay")
+        << "recorded " << m_inputs.size() << " inputs over "
+        << m_final_tick << " ticks: " << m_path;
+    return true;
+}
+
+bool Replay::load(std::filesystem::path const& path)
+{
+    std::ifstream in { path, std::ios::binary };
+    if (!in)
+    {
+        ORBIT_LOG(Error, "core/replay") << "cannot read: " << path;
+        return false;
+    }
+
+    uint32_t const magic { read_u32(in) };
+    uint16_t const version { read_u16(in) };
+    if (magic != param_file_magic || version == 0 || version > param_file_version)
+    {
+        ORBIT_LOG(Error, "core/replay") << "not a replay (or unsupported version): " << path;
+        return false;
+    }
+
+    if (version < param_min_file_version)
+    {
+        ORBIT_LOG(Error, "core/replay") << "recorded by an older build (it would play out differently): " << path;
+        return false;
+    }
+
+    m_tick_rate = read_u32(in);
+    m_final_tick = read_u32(in);
+    m_seeds.level = read_u32(in);
+    m_seeds.player = read_u32(in);
+    m_seeds.particles = read_u32(in);
+
+    m_level_config.planet_count = read_u32(in);
+    m_level_config.extent_scaling_factor = read_f32(in);
+    m_level_config.planet_padding = read_f32(in);
+    m_level_config.moon_chance = read_f32(in);
+
+    m_inputs.clear();
+    uint32_t tick { 0 };
+    while (in.peek() != std::char_traits<char>::eof())
+    {
+        ReplayInput input;
+        tick += read_varint(in);
+        input.tick = tick;
+        input.type = static_cast<ReplayInputType>(read_u8(in));
+
+        switch (input.type)
+        {
+        case ReplayInputType::KeyPressed:
+            input.key = static_cast<sf::Keyboard::Key>(static_cast<int8_t>(read_u8(in))); break;
+        case ReplayInputType::MouseSeek:
+            input.position.x = read_f32(in);
+            input.position.y = read_f32(in);
+            break;
+        case ReplayInputType::MouseClick: break;
+        }
+
+        if (!in)
+        {
+            ORBIT_LOG(Error, "core/replay") << "truncated replay: " << path;
+            return false;
+        }
+        m_inputs.push_back(input);
+    }
+
+    m_path = path;
+    m_playing = true;
+    m_recording = false;
+    m_cursor = 0;
+    return true;
+}
+
+bool Replay::next(uint32_t const tick, ReplayInput& input)
+{
+    if (!m_playing || m_cursor >= m_inputs.size()) return false;
+    if (m_inputs[m_cursor].tick != tick) return false;
+
+    input = m_inputs[m_cursor++];
+    return true;
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstring>
+#include "Core/Rewind.hpp"
+#include "Core/Level.hpp"
+#include "Core/Log.hpp"
+#include "Core/Navigation.hpp"
+#include "Core/Universe.hpp"
+#include "Core/WorldOrigin.hpp"
+#include "Graphics/Particles.hpp"
+
+namespace
+{
+    constexpr size_t align_up(size_t const offset, size_t const alignment)
+    { return (offset + alignment - 1) / alignment * alignment; }
+}
+
+void Rewind::init()
+{
+    m_planet_count = m_universe.get_level().get_planets().size();
+
+    /* Every offset (and the stride itself) is aligned,
+     * so fields can be read & written in place */
+    m_mass_offset = align_up(sizeof(SnapshotHeader), alignof(float));
+    m_orbit_bits_offset = m_mass_offset + m_planet_count * sizeof(float);
+    m_particles_offset = align_up(m_orbit_bits_offset + (m_planet_count + 7) / 8, alignof(ParticleSnapshot));
+    m_stride = align_up(
+        m_particles_offset + param_max_particles * sizeof(ParticleSnapshot),
+        std::max(alignof(SnapshotHeader), alignof(ParticleSnapshot))
+    );
+
+    m_capacity = static_cast<size_t>(param_capacity_seconds * static_cast<float>(m_universe.get_tick_rate()));
+    m_buffer.assign(m_stride * m_capacity, std::byte{0});
+    m_head = m_count = 0;
+
+    ORBIT_LOG(Info, "core/rewind")
+        << m_capacity << " snapshots x " << m_stride << " bytes = "
+        << get_memory_usage() / 1024 << " KiB";
+}
+
+std::byte* Rewind::get_slot(size_t const index)
+{
+    return m_buffer.data() + index * m_stride;
+}
+
+void Rewind::capture()
+{
+    Navigation const& navigation { m_universe.get_navigation() };
+    if (m_capacity == 0 || !navigation.has_context()) return;
+
+    ParticleEmitter const& particles { m_universe.get_particles() };
+    auto const& planets { m_universe.get_level().get_planets() };
+    assert(planets.size() == m_planet_count);
+    assert(particles.get_particle_count() <= param_max_particles);
+
+    std::byte* const slot { get_slot(m_head) };
+    auto const& ctx { navigation.get_context() };
+
+    auto* const header { reinterpret_cast<SnapshotHeader*>(slot) };
+    *header = {
+        .player = m_universe.get_player().save(),
+        .origin_cell = m_universe.get_origin().get_cell(),
+        .motion_tick = m_universe.get_level().get_motion_tick(),
+        .previous_planet = static_cast<uint32_t>(&ctx.previous_planet - planets.data()),
+        .particle_count = static_cast<uint32_t>(particles.get_particle_count()),
+    };
+
+    /* Planet masses (Assist adjusts them) & orbit states */
+    auto* const masses { reinterpret_cast<float*>(slot + m_mass_offset) };
+    auto* const orbit_bits { reinterpret_cast<uint8_t*>(slot + m_orbit_bits_offset) };
+    std::memset(orbit_bits, 0, (m_planet_count + 7) / 8);
+
+    for (size_t idx = 0; idx < m_planet_count; ++idx)
+    {
+        masses[idx] = planets[idx].get_mass();
+        if (planets[idx].get_orbit().is_on()) orbit_bits[idx / 8] |= 1 << (idx % 8);
+    }
+
+    particles.save(reinterpret_cast<ParticleSnapshot*>(slot + m_particles_offset));
+
+    m_head = (m_head + 1) % m_capacity;
+    m_count = std::min(m_count + 1, m_capacity);
+}
+
+bool Rewind::step_back()
+{
+    if (m_count == 0) return false;
+
+    sf::Clock restore_clock;
+
+    m_head = (m_head + m_capacity - 1) % m_capacity;
+    --m_count;
+
+    auto& planets { m_universe.get_level().get_planets() };
+    std::byte const* const slot { get_slot(m_head) };
+
+    auto const* const header { reinterpret_cast<SnapshotHeader const*>(slot) };
+    auto const* const masses { reinterpret_cast<float const*>(slot + m_mass_offset) };
+    auto const* const orbit_bits { reinterpret_cast<uint8_t const*>(slot + m_orbit_bits_offset) };
+
+    m_universe.get_origin().rebase_to(header->origin_cell); /* Snapshot predates a rebase */
+    m_universe.get_level().set_motion_tick(header->motion_tick, m_universe.get_delta_time());
+
+    for (size_t idx = 0; idx < m_planet_count; ++idx)
+    {
+        planets[idx].set_mass(masses[idx]);
+        planets[idx].get_orbit().set_state(orbit_bits[idx / 8] & (1 << (idx % 8))); /* Flag & on-screen ring fill only */
+    }
+
+    m_universe.get_particles().restore(
+        reinterpret_cast<ParticleSnapshot const*>(slot + m_particles_offset),
+        header->particle_count
+    );
+
+    m_universe.get_player().restore(header->player);
+    m_universe.get_navigation().restore_context(planets[header->previous_planet]); // needs player & orbits restored first
+
+    m_last_restore_us = static_cast<float>(restore_clock.getElapsedTime().asMicroseconds());
+    return true;
+}
@@ -0,0 +1,159 @@
+#include "Core/Simulation.hpp"
+#include "Core/Assist.hpp"
+#include "Core/Level.hpp"
+#include "Core/Navigation.hpp"
+#include "Entity/Player.hpp"
+#include "Math/Random.hpp"
+#include "Math/Vector2.hpp"
+
+ShipEvent Simulation::step(
+    ShipState& ship, float const dt,
+    std::vector<Planet> const& planets, PlanetArrays const& arrays
+)
+{
+    /* Navigation: collision, then nearest ON orbit */
+    Vector2ConstSpan const positions { arrays.position.span() };
+
+    uint32_t const collided {
+        Vector2Batch::first_within(positions, arrays.radius.data(), Player::param_visual_core_radius, ship.position)
+    };
+    if (collided != Vector2Batch::npos) return ShipEvent::Collided;
+
+    uint32_t const target { Vector2Batch::nearest(positions, ship.position, nullptr, ship.excluded).index };
+    if (target == ShipState::npos) return ShipEvent::Lost;
+
+    if (target != ship.target)
+    {
+        /* Same rule as Navigation::ctx_get_previous_planet() */
+        if (ship.stable && ship.target != ShipState::npos) ship.previous = ship.target;
+        ship.target = target;
+        ship.target_mass = planets[target].get_mass();
+    }
+
+    Orbit const& target_orbit { planets[target].get_orbit() };
+    float const target_radius { target_orbit.get_radius() };
+    sf::Vector2f const distance_vec { ship.position - target_orbit.get_origin() };
+    float const distance { distance_vec.length() };
+    float const error { distance - target_radius };
+
+    /* Velocity components; same as Navigation::ctx_get_velocity_components() */
+    sf::Vector2f const velocity { (ship.position - ship.previous_position) / dt };
+    sf::Vector2f v_radial;
+    if (distance > 0.0f) v_radial = velocity.projectedOnto(distance_vec);
+    sf::Vector2f v_tangent { velocity - v_radial };
+    if (v_radial.length() < 1.0f) v_radial *= 0.0f;
+    if (v_tangent.length() < 1.0f) v_tangent *= 0.0f;
+
+    /* Classification; same as Player::is() */
+    PlayerStateMask const state { Player::classify(error, v_radial) };
+    float const v_radial_mag { v_radial.length() };
+
+    bool const far_outside { (state & player_state_mask(PlayerState::FarOutsideOrbit)) != 0 };
+    bool const inside_smoothing_ring { (state & player_state_mask(PlayerState::InsideSmoothingRing)) != 0 };
+    bool const stable { (state & player_state_mask(PlayerState::InStableOrbit)) != 0 };
+
+    ShipEvent const event {
+        (stable && !ship.stable)
+        ? ShipEvent::Captured
+        : ShipEvent::None
+    };
+    ship.stable = stable;
+
+    /* Assist; same as Assist::update() */
+    if (far_outside)
+        ship.target_mass =
+            (1.0f + Assist::param_assist_planet_mass_boosting_power)
+            * (v_tangent.lengthSquared() * target_radius) / Navigation::G;
+
+    if (inside_smoothing_ring && v_radial_mag <= Assist::param_assist_radial_smoothing_threshold)
+    {
+        v_radial *= std::pow(Assist::param_assist_radial_smoothing_factor, dt);
+
+        float const v_tangent_error { Player::param_target_orbital_velocity - v_tangent.length() };
+        if (std::abs(v_tangent_error) > Assist::param_assist_tangent_correction_tolerance_factor)
+        {
+            float const tangent_correction_factor {
+                (v_tangent_error > 0.0f)
+                ? Assist::param_assist_tangent_boosting_factor
+                : Assist::param_assist_tangent_smoothing_factor
+            };
+            v_tangent *= std::pow(tangent_correction_factor, dt);
+        }
+
+        ship.target_mass = (v_tangent.lengthSquared() * (target_radius + error)) / Navigation::G;
+        ship.previous_position = ship.position - (v_radial + v_tangent) * dt;
+    }
+
+    advance(ship.position, ship.previous_position, target_orbit.get_origin(), ship.target_mass, far_outside, dt);
+
+    return event;
+}
+
+sf::Vector2f Simulation::get_gravity(sf::Vector2f const& position, sf::Vector2f const& focus, float const mass)
+{
+    sf::Vector2f const distance_vec { position - focus };
+    float const distance { distance_vec.length() };
+    if (distance <= 1.0f) return {}; // Too close = massive force
+
+    sf::Vector2f const direction { -distance_vec.normalized() };
+    return direction * ((Navigation::G * mass) / (distance * distance));
+}
+
+void Simulation::integrate(
+    sf::Vector2f& position, sf::Vector2f& previous_position,
+    sf::Vector2f const& acceleration, float const dt
+)
+{
+    sf::Vector2f const current_position { position };
+    position = 2.0f * current_position - previous_position + acceleration * (dt * dt);
+    previous_position = current_position;
+}
+
+void Simulation::advance(
+    sf::Vector2f& position, sf::Vector2f& previous_position,
+    sf::Vector2f const& focus, float const mass, bool const far_outside, float const dt
+)
+{
+    sf::Vector2f acceleration { get_gravity(position, focus, mass) };
+
+    /* Drift clamp; Player::set_velocity() nulls the acceleration */
+    sf::Vector2f const velocity { (position - previous_position) / dt };
+    if (far_outside && velocity.length() > Player::param_max_drift_velocity)
+    {
+        previous_position = position - velocity.normalized() * Player::param_max_drift_velocity * dt;
+        acceleration = {0.0f, 0.0f};
+    }
+
+    integrate(position, previous_position, acceleration, dt);
+}
+
+void Simulation::place_on_orbit(
+    ShipState& ship, uint32_t const planet_idx, float const dt,
+    std::vector<Planet> const& planets, Xoshiro128& random
+)
+{
+    uid<int32_t> coin { 0, 1 };
+    auto const sign { [&] { return coin(random) ? 1.0f : -1.0f; } };
+
+    Planet const& planet { planets[planet_idx] };
+    Orbit const& orbit { planet.get_orbit() };
+
+    size_t const offset_axis { static_cast<size_t>(coin(random)) };
+
+    float vec_buf[2] { 0 };
+    vec_buf[offset_axis] = sign() * orbit.get_radius();
+    sf::Vector2f const position { orbit.get_origin() + sf::Vector2f{vec_buf[0], vec_buf[1]} };
+
+    vec_buf[!offset_axis] = sign() * Player::param_target_orbital_velocity;
+    vec_buf[offset_axis] = vec_buf[!offset_axis] * 0.1f; // some radial noise
+    sf::Vector2f const velocity { vec_buf[0], vec_buf[1] };
+
+    ship.position = position;
+    ship.previous_position = position - velocity * dt;
+
+    ship.target = planet_idx;
+    ship.previous = planet_idx;
+    ship.target_mass = planet.get_mass();
+    if (ship.excluded == planet_idx) ship.excluded = ShipState::npos; // respawn orbit is ON
+    ship.stable = false;
+}
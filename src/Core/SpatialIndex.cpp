@@ -0,0 +1,122 @@
+#include <cmath>
+#include <limits>
+#include "Core/SpatialIndex.hpp"
+
+void SpatialIndex::build(
+    Vector2ConstSpan const points, sf::Vector2f const& min, sf::Vector2f const& max, float const cell_size
+)
+{
+    m_min = min;
+    m_cell_size = cell_size;
+    m_columns = std::max(1, static_cast<int32_t>(std::ceil((max.x - min.x) / cell_size)));
+    m_rows = std::max(1, static_cast<int32_t>(std::ceil((max.y - min.y) / cell_size)));
+
+    m_head.assign(static_cast<size_t>(m_columns) * m_rows, npos);
+    m_next.assign(points.size, npos);
+    m_prev.assign(points.size, npos);
+    m_cell.assign(points.size, 0);
+
+    for (uint32_t idx = 0; idx < points.size; ++idx)
+        link(idx, get_cell_index(get_cell({ points.x[idx], points.y[idx] })));
+}
+
+void SpatialIndex::clear()
+{
+    m_head.clear();
+    m_next.clear();
+    m_prev.clear();
+    m_cell.clear();
+    m_columns = m_rows = 0;
+}
+
+void SpatialIndex::link(uint32_t const idx, uint32_t const cell)
+{
+    m_cell[idx] = cell;
+    m_prev[idx] = npos;
+    m_next[idx] = m_head[cell];
+    if (m_head[cell] != npos) m_prev[m_head[cell]] = idx;
+    m_head[cell] = idx;
+}
+
+void SpatialIndex::unlink(uint32_t const idx)
+{
+    if (m_prev[idx] != npos) m_next[m_prev[idx]] = m_next[idx];
+    else m_head[m_cell[idx]] = m_next[idx];
+
+    if (m_next[idx] != npos) m_prev[m_next[idx]] = m_prev[idx];
+}
+
+void SpatialIndex::move(uint32_t const idx, sf::Vector2f const& position)
+{
+    uint32_t const cell { get_cell_index(get_cell(position)) };
+    if (cell == m_cell[idx]) return; /* Most moves; nothing to do */
+
+    unlink(idx);
+    link(idx, cell);
+    ++m_relink_count;
+}
+
+Vector2Nearest SpatialIndex::nearest(
+    Vector2ConstSpan const points, sf::Vector2f const& from,
+    uint8_t const* const mask, uint32_t const exclude
+) const
+{
+    Vector2Nearest best;
+    if (m_head.empty()) return best;
+
+    auto const visit_cell { [&](int32_t const x, int32_t const y)
+    {
+        for (uint32_t idx = m_head[get_cell_index({ x, y })]; idx != npos; idx = m_next[idx])
+        {
+            if (idx == exclude || (mask && !mask[idx])) continue;
+
+            float const dx { points.x[idx] - from.x };
+            float const dy { points.y[idx] - from.y };
+            float const distance_squared { dx * dx + dy * dy };
+
+            /* Ties go to the lower index; same as a linear scan */
+            if (
+                best.index == npos || distance_squared < best.distance_squared
+                || (distance_squared == best.distance_squared && idx < best.index)
+            ) best = { idx, distance_squared };
+        }
+    } };
+
+    /* Rings of cells around the one `from` falls in (or is clamped to) */
+    sf::Vector2i const center { get_cell(from) };
+    int32_t const max_ring {
+        std::max({ center.x, m_columns - 1 - center.x, center.y, m_rows - 1 - center.y })
+    };
+
+    for (int32_t ring = 0; ring <= max_ring; ++ring)
+    {
+        for (int32_t y = center.y - ring; y <= center.y + ring; ++y)
+        {
+            if (y < 0 || y >= m_rows) continue;
+
+            bool const is_edge_row { y == center.y - ring || y == center.y + ring };
+            int32_t const step { (is_edge_row || ring == 0) ? 1 : 2 * ring };
+            for (int32_t x = center.x - ring; x <= center.x + ring; x += step)
+                if (x >= 0 && x < m_columns) visit_cell(x, y);
+        }
+
+        if (best.index == npos) continue;
+
+        /* Cells not visited yet lie beyond one of the sides of the
+         * visited block that are not on the border of the grid */
+        float bound { std::numeric_limits<float>::infinity() };
+        if (center.x - ring > 0)
+            bound = std::min(bound, from.x - (m_min.x + static_cast<float>(center.x - ring) * m_cell_size));
+        if (center.x + ring < m_columns - 1)
+            bound = std::min(bound, m_min.x + static_cast<float>(center.x + ring + 1) * m_cell_size - from.x);
+        if (center.y - ring > 0)
+            bound = std::min(bound, from.y - (m_min.y + static_cast<float>(center.y - ring) * m_cell_size));
+        if (center.y + ring < m_rows - 1)
+            bound = std::min(bound, m_min.y + static_cast<float>(center.y + ring + 1) * m_cell_size - from.y);
+
+        bound = std::max(bound, 0.0f);
+        if (best.distance_squared < bound * bound) break;
+    }
+
+    return best;
+}
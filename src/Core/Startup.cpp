@@ -0,0 +1,34 @@
+#include <cstdio>
+#include <iterator>
+#include "Core/Startup.hpp"
+#include "Core/Log.hpp"
+
+namespace
+{
+    constexpr char const* phase_names[] {
+        "main", "loading view", "level", "neighborhood", "first frame"
+    };
+    static_assert(std::size(phase_names) == static_cast<size_t>(StartupPhase::Count));
+}
+
+void Startup::mark(StartupPhase const phase)
+{
+    if (has_reached(phase)) return;
+    m_ms[static_cast<size_t>(phase)] = m_clock.getElapsedTime().asSeconds() * 1000.0f;
+}
+
+void Startup::print() const
+{
+    ORBIT_LOG(Info, "core/startup") << "time to first frame: " << get_time_to_first_frame_ms() << "ms";
+
+    float previous_ms { 0.0f };
+    for (size_t idx = 0; idx < m_ms.size(); ++idx)
+    {
+        if (m_ms[idx] < 0.0f) continue; /* e.g. no loading view when headless */
+
+        char row[64];
+        std::snprintf(row, sizeof(row), "  %-13s %9.2fms  (+%.2fms)", phase_names[idx], m_ms[idx], m_ms[idx] - previous_ms);
+        ORBIT_LOG(Info, "core/startup") << row;
+        previous_ms = m_ms[idx];
+    }
+}
@@ -0,0 +1,214 @@
+#include <iterator>
+#include "Core/Swarm.hpp"
+#include "Core/Level.hpp"
+#include "Core/Log.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Universe.hpp"
+#include "Graphics/Window.hpp"
+#include "Math/Vector2.hpp"
+
+void SwarmBots::resize(size_t const count)
+{
+    position.resize(count);
+    previous_position.resize(count);
+    target.resize(count, ShipState::npos);
+    previous.resize(count, ShipState::npos);
+    excluded.resize(count, ShipState::npos);
+    target_mass.resize(count, 0.0f);
+    stable_time.resize(count, 0.0f);
+    release_time.resize(count, 0.0f);
+    stable.resize(count, 0);
+    random.resize(count);
+}
+
+ShipState SwarmBots::load(size_t const idx) const
+{
+    return {
+        .position = position[idx],
+        .previous_position = previous_position[idx],
+        .target = target[idx],
+        .previous = previous[idx],
+        .excluded = excluded[idx],
+        .target_mass = target_mass[idx],
+        .stable = stable[idx] != 0,
+    };
+}
+
+void SwarmBots::store(size_t const idx, ShipState const& ship)
+{
+    position[idx] = ship.position;
+    previous_position[idx] = ship.previous_position;
+    target[idx] = ship.target;
+    previous[idx] = ship.previous;
+    excluded[idx] = ship.excluded;
+    target_mass[idx] = ship.target_mass;
+    stable[idx] = ship.stable;
+}
+
+void Swarm::spawn(uint32_t const count)
+{
+    auto const& planets { m_universe.get_level().get_planets() };
+    assert(!planets.empty());
+
+    clear();
+    m_bots.resize(count);
+    m_vertices.resize(static_cast<size_t>(count) * 3);
+
+    /* Non-overlapping streams off one seed; bot idx is idx jumps in */
+    Xoshiro128 stream { param_bot_seed };
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        auto& random { m_bots.random[idx] };
+        random = stream;
+        stream.jump();
+
+        uid<uint32_t> planet_dist { 0, static_cast<uint32_t>(planets.size() - 1) };
+        ufd release_time_dist { param_bot_release_time_dist };
+
+        uint32_t const planet_idx { planet_dist(random) };
+        m_bots.release_time[idx] = release_time_dist(random);
+        respawn_bot(idx, planet_idx);
+    }
+}
+
+void Swarm::clear()
+{
+    m_bots.resize(0);
+    m_vertices.clear();
+    m_releases = m_captures = m_explosions = 0;
+}
+
+void Swarm::rebase(sf::Vector2f const& shift)
+{
+    for (size_t idx = 0; idx < m_bots.size(); ++idx)
+    {
+        m_bots.position[idx] -= shift;
+        m_bots.previous_position[idx] -= shift;
+    }
+    rebuild_vertices(0, m_bots.size());
+}
+
+void Swarm::respawn_bot(size_t const idx, uint32_t const planet_idx)
+{
+    ShipState ship { m_bots.load(idx) };
+    Simulation::place_on_orbit(
+        ship, planet_idx, m_universe.get_delta_time(), m_universe.get_level().get_planets(), m_bots.random[idx]
+    );
+    m_bots.store(idx, ship);
+
+    m_bots.stable_time[idx] = 0.0f;
+}
+
+void Swarm::update_bot(size_t const idx, float const dt)
+{
+    ShipState ship { m_bots.load(idx) };
+
+    Level const& level { m_universe.get_level() };
+
+    /* Stable around a moon => carried along with it; same as the player */
+    if (ship.stable && ship.target != ShipState::npos)
+    {
+        sf::Vector2f const displacement { level.get_displacement(ship.target) };
+        ship.position += displacement;
+        ship.previous_position += displacement;
+    }
+
+    switch (Simulation::step(ship, dt, level.get_planets(), level.get_planet_arrays()))
+    {
+    case ShipEvent::Collided:
+    case ShipEvent::Lost:
+        ++m_explosions;
+        return respawn_bot(idx, (ship.previous != ShipState::npos) ? ship.previous : ship.target);
+
+    case ShipEvent::Captured: ++m_captures; break;
+    default: break;
+    }
+
+    /* Release policy: hang around in a stable orbit for a while, then let go */
+    if (!ship.stable) m_bots.stable_time[idx] = 0.0f;
+    else if ((m_bots.stable_time[idx] += dt) >= m_bots.release_time[idx])
+    {
+        ufd release_time_dist { param_bot_release_time_dist };
+        Simulation::release(ship);
+        m_bots.stable_time[idx] = 0.0f;
+        m_bots.release_time[idx] = release_time_dist(m_bots.random[idx]);
+        ++m_releases;
+    }
+
+    m_bots.store(idx, ship);
+}
+
+void Swarm::update()
+{
+    if (!is_active()) return;
+
+    float const dt { m_universe.get_delta_time() };
+    sf::Clock tick_clock;
+
+    ThreadPool.parallel_for(m_bots.size(), [this, dt](size_t const begin, size_t const end)
+    {
+        for (size_t idx = begin; idx < end; ++idx) update_bot(idx, dt);
+        rebuild_vertices(begin, end);
+    });
+
+    update_sweep(tick_clock.getElapsedTime().asSeconds());
+}
+
+void Swarm::update_sweep(float const tick_seconds)
+{
+    if (!is_sweeping()) return;
+
+    m_sweep_seconds += tick_seconds;
+    if (++m_sweep_ticks < param_sweep_ticks_per_step) return;
+
+    double const seconds_per_tick { m_sweep_seconds / m_sweep_ticks };
+    ORBIT_LOG(Info, "core/swarm")
+        << "bots: " << m_bots.size()
+        << " | threads: " << ThreadPool.get_thread_count()
+        << " | ticks/s: " << 1.0 / seconds_per_tick
+        << " | ms/tick: " << seconds_per_tick * 1000.0
+        << " | releases: " << m_releases.load()
+        << " | captures: " << m_captures.load()
+        << " | explosions: " << m_explosions.load();
+
+    if (++m_sweep_step == std::size(param_sweep_bot_counts)) return stop_sweep();
+
+    m_sweep_ticks = 0;
+    m_sweep_seconds = 0.0;
+    spawn(param_sweep_bot_counts[m_sweep_step]);
+}
+
+void Swarm::start_sweep()
+{
+    m_sweep_step = 0;
+    m_sweep_ticks = 0;
+    m_sweep_seconds = 0.0;
+    spawn(param_sweep_bot_counts[m_sweep_step]);
+}
+
+void Swarm::stop_sweep()
+{
+    m_sweep_step = std::size(param_sweep_bot_counts);
+    clear();
+}
+
+void Swarm::rebuild_vertices(size_t const begin, size_t const end)
+{
+    constexpr float half_size { param_visual_bot_size / 2.0f };
+
+    for (size_t idx = begin; idx < end; ++idx)
+    {
+        sf::Vector2f const& position { m_bots.position[idx] };
+        size_t const vertex { idx * 3 };
+
+        m_vertices[vertex + 0] = { .position = position + sf::Vector2f{0.0f, -half_size}, .color = param_visual_bot_color };
+        m_vertices[vertex + 1] = { .position = position + sf::Vector2f{-half_size, half_size}, .color = param_visual_bot_color };
+        m_vertices[vertex + 2] = { .position = position + sf::Vector2f{half_size, half_size}, .color = param_visual_bot_color };
+    }
+}
+
+void Swarm::draw() const
+{
+    if (!is_active()) return;
+    Window.draw(m_vertices);
+}
@@ -0,0 +1,94 @@
+#include <cassert>
+#include <thread>
+#include "Core/TaskGraph.hpp"
+
+TaskGraph::TaskId TaskGraph::add(
+    std::function<void()> fn,
+    std::initializer_list<TaskId> const depends_on,
+    TaskAffinity const affinity
+)
+{
+    auto const id { static_cast<TaskId>(m_tasks.size()) };
+
+    for (TaskId const dependency : depends_on)
+    {
+        assert(dependency < id); /* Added before; keeps the graph acyclic */
+        m_tasks[dependency].successors.push_back(id);
+    }
+
+    Task& task { m_tasks.emplace_back(std::move(fn), affinity) };
+    task.dependency_count = static_cast<uint32_t>(depends_on.size());
+
+    m_caller_ready.reserve(m_tasks.size());
+    return id;
+}
+
+void TaskGraph::run(ThreadPool_t* const pool)
+{
+    [[maybe_unused]] bool const was_running { m_running.exchange(true) };
+    assert(!was_running); /* See run(); m_remaining & m_caller_ready are per graph */
+
+    if (!pool)
+    {
+        for (Task& task : m_tasks) task.fn();
+        m_running = false;
+        return;
+    }
+
+    m_pool = pool;
+    m_caller_ready.clear();
+    m_caller_next = 0;
+
+    for (Task& task : m_tasks) task.pending.store(task.dependency_count, std::memory_order_relaxed);
+    m_remaining.add(static_cast<uint32_t>(m_tasks.size()));
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+        if (m_tasks[id].dependency_count == 0) schedule(id);
+
+    while (!m_remaining.is_done())
+    {
+        TaskId id { 0 };
+        bool has_caller_task { false };
+        {
+            std::lock_guard const lock { m_caller_mutex };
+            if (m_caller_next < m_caller_ready.size())
+            {
+                id = m_caller_ready[m_caller_next++];
+                has_caller_task = true;
+            }
+        }
+
+        if (has_caller_task) run_task(id);
+        else if (!pool->try_run_one()) std::this_thread::yield();
+    }
+
+    m_pool = nullptr;
+    m_running = false;
+}
+
+void TaskGraph::schedule(TaskId const id)
+{
+    if (m_tasks[id].affinity == TaskAffinity::Caller)
+    {
+        std::lock_guard const lock { m_caller_mutex };
+        m_caller_ready.push_back(id);
+        return;
+    }
+
+    m_pool->push({
+        [](void* const context, size_t const begin, size_t)
+        { static_cast<TaskGraph*>(context)->run_task(static_cast<TaskId>(begin)); },
+        this, id, id + 1, nullptr
+    });
+}
+
+void TaskGraph::run_task(TaskId const id)
+{
+    Task& task { m_tasks[id] };
+    task.fn();
+
+    for (TaskId const successor : task.successors)
+        if (m_tasks[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) schedule(successor);
+
+    m_remaining.count_down();
+}
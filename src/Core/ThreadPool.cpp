@@ -0,0 +1,181 @@
+#include <algorithm>
+#include "Core/ThreadPool.hpp"
+
+namespace
+{
+    /* The pool & deque this thread works for; null outside of any pool */
+    thread_local ThreadPool_t const* t_pool { nullptr };
+    thread_local uint32_t t_worker_index { 0 };
+}
+
+bool JobDeque::push(Job const& job)
+{
+    std::lock_guard const lock { m_mutex };
+    if (m_tail - m_head == param_capacity) return false;
+
+    m_jobs[m_tail++ % param_capacity] = job;
+    return true;
+}
+
+bool JobDeque::pop(Job& job)
+{
+    std::lock_guard const lock { m_mutex };
+    if (m_tail == m_head) return false;
+
+    job = m_jobs[--m_tail % param_capacity];
+    return true;
+}
+
+bool JobDeque::steal(Job& job)
+{
+    std::lock_guard const lock { m_mutex };
+    if (m_tail == m_head) return false;
+
+    job = m_jobs[m_head++ % param_capacity];
+    return true;
+}
+
+ThreadPool::ThreadPool(uint32_t worker_count)
+{
+    if (worker_count == 0)
+        worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    /* Before any worker starts; they index into it */
+    m_deques.reserve(worker_count + 1);
+    for (uint32_t idx = 0; idx < worker_count + 1; ++idx)
+        m_deques.push_back(std::make_unique<JobDeque>());
+
+    m_workers.reserve(worker_count);
+    for (uint32_t idx = 0; idx < worker_count; ++idx)
+        m_workers.emplace_back(&ThreadPool::worker_loop, this, idx);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard const lock { m_sleep_mutex };
+        m_stopping = true;
+    }
+    m_sleep_condition.notify_all();
+
+    for (auto& worker : m_workers) worker.join();
+}
+
+bool ThreadPool::is_worker_thread() { return t_pool != nullptr; }
+
+JobDeque& ThreadPool::get_local_deque()
+{
+    return (t_pool == this) ? *m_deques[t_worker_index] : *m_deques.back();
+}
+
+void ThreadPool::push(Job const& job)
+{
+    m_queued.fetch_add(1);
+    if (!get_local_deque().push(job))
+    {
+        m_queued.fetch_sub(1);
+        return run(job); /* Full; no room to defer it */
+    }
+
+    /* Pairs with the sleeper count going up before a worker
+     * checks m_queued; one of the two always sees the other */
+    if (m_sleepers.load() > 0)
+    {
+        { std::lock_guard const lock { m_sleep_mutex }; }
+        m_sleep_condition.notify_one();
+    }
+}
+
+bool ThreadPool::try_take(Job& job)
+{
+    size_t const deque_count { m_deques.size() };
+    size_t const local { (t_pool == this) ? t_worker_index : deque_count - 1 };
+
+    if (m_deques[local]->pop(job))
+    {
+        m_queued.fetch_sub(1);
+        return true;
+    }
+
+    /* Victims in order, starting past our own deque; spreads the thieves out */
+    for (size_t offset = 1; offset < deque_count; ++offset)
+    {
+        if (m_deques[(local + offset) % deque_count]->steal(job))
+        {
+            m_queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(Job const& job)
+{
+    job.invoke(job.context, job.begin, job.end);
+    if (job.latch) job.latch->count_down();
+}
+
+bool ThreadPool::try_run_one()
+{
+    Job job;
+    if (!try_take(job)) return false;
+
+    run(job);
+    return true;
+}
+
+void ThreadPool::wait(JobLatch const& latch)
+{
+    while (!latch.is_done())
+        if (!try_run_one()) std::this_thread::yield(); /* The rest is running elsewhere */
+}
+
+void ThreadPool::parallel_for_impl(size_t const count, void (* const invoke)(void*, size_t, size_t), void* const context)
+{
+    if (count == 0) return;
+
+    size_t const chunk_count { std::min<size_t>(count, get_thread_count() * param_chunks_per_thread) };
+    if (get_worker_count() == 0 || chunk_count == 1) return invoke(context, 0, count);
+
+    auto const chunk_begin { [count, chunk_count](size_t const chunk) { return count * chunk / chunk_count; } };
+
+    /* Jobs only reference the latch while this call waits on it */
+    JobLatch latch { static_cast<uint32_t>(chunk_count - 1) };
+
+    /* Last chunk first; we pop our own back (chunk 1 onwards)
+     * while thieves take the far end from the front */
+    for (size_t chunk = chunk_count - 1; chunk > 0; --chunk)
+        push({ invoke, context, chunk_begin(chunk), chunk_begin(chunk + 1), &latch });
+
+    invoke(context, 0, chunk_begin(1)); // caller takes the first chunk
+    wait(latch);
+}
+
+void ThreadPool::worker_loop(uint32_t const index)
+{
+    t_pool = this;
+    t_worker_index = index;
+
+    uint32_t idle_spins { 0 };
+    while (!m_stopping.load())
+    {
+        if (try_run_one())
+        {
+            idle_spins = 0;
+            continue;
+        }
+
+        if (++idle_spins < param_idle_spins)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        idle_spins = 0;
+        std::unique_lock lock { m_sleep_mutex };
+        m_sleepers.fetch_add(1);
+        m_sleep_condition.wait(lock, [this] { return m_stopping.load() || m_queued.load() > 0; });
+        m_sleepers.fetch_sub(1);
+    }
+}
@@ -0,0 +1,47 @@
+#include <fstream>
+#include "Core/Trace.hpp"
+#include "Core/Log.hpp"
+
+Trace::Trace()
+    : m_epoch{Clock::now()}, m_thread{std::this_thread::get_id()}
+{
+#ifdef ORBIT_PROFILER
+    m_events.resize(param_capacity);
+#endif
+}
+
+bool Trace::dump(std::filesystem::path const& path) const
+{
+    std::ofstream file { path };
+    if (!file)
+    {
+        ORBIT_LOG(Error, "core/trace") << "cannot open " << path;
+        return false;
+    }
+
+    /* Oldest first; the ring may start with End events
+     * of scopes that began before the overwritten part, the viewers ignore those */
+    size_t const first { (m_head + param_capacity - m_count) % param_capacity };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t idx = 0; idx < m_count; ++idx)
+    {
+        TraceEvent const& event { m_events[(first + idx) % param_capacity] };
+
+        /* ts is in microseconds; keep sub-microsecond precision */
+        file
+            << (idx ? ",\n" : "")
+            << "{\"name\":\"" << event.name << "\",\"ph\":\"" << static_cast<char>(event.phase)
+            << "\",\"ts\":" << event.timestamp_ns / 1000 << '.'
+            << static_cast<char>('0' + event.timestamp_ns / 100 % 10)
+            << static_cast<char>('0' + event.timestamp_ns / 10 % 10)
+            << static_cast<char>('0' + event.timestamp_ns % 10)
+            << ",\"pid\":1,\"tid\":1"
+            << (event.phase == TracePhase::Instant ? ",\"s\":\"g\"" : "")
+            << "}";
+    }
+    file << "\n]}\n";
+
+    ORBIT_LOG(Info, "core/trace") << "wrote " << m_count << " events to " << path;
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,138 @@
+#include "Core/Universe.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Trace.hpp"
+
+Universe::Universe(uint32_t const tick_rate)
+    : m_tick_rate{tick_rate},
+      m_origin{*this},
+      m_navigation{*this},
+      m_assist{*this},
+      m_particles{*this},
+      m_player{*this},
+      m_prediction{*this},
+      m_rewind{*this},
+      m_swarm{*this},
+      m_launch_solver{*this}
+{
+    m_navigation.subscribe([this](NavigationEvent const& event) { m_assist.on_navigation_event(event); });
+    build_frame_graph();
+}
+
+void Universe::seed(ReplaySeeds const& seeds)
+{
+    m_player.seed(seeds.player);
+    m_particles.seed(seeds.particles);
+}
+
+void Universe::update()
+{
+    m_frame_arena.reset(); /* Previous tick's transients */
+
+    if (m_rewind.is_rewinding())
+    {
+        /* Step back one tick per frame, until the buffer runs dry */
+        ORBIT_PROFILE_SCOPE(Rewind);
+        if (!m_rewind.step_back()) m_rewind.stop();
+        return;
+    }
+
+    m_origin.update(m_player.get_position());
+
+    {
+        ORBIT_PROFILE_SCOPE(Rewind);
+        m_rewind.capture();
+    }
+
+    advance_motion();
+
+    if (m_particles.is_active())
+    {
+        /* Block the update loop
+         * while the particle emitter is active
+         * FIXME: process_input() is still being called */
+        {
+            ORBIT_PROFILE_SCOPE(Swarm);
+            m_swarm.update();
+        }
+
+        ORBIT_PROFILE_SCOPE(Particles);
+        return m_particles.update();
+    }
+
+    m_frame_graph.run(m_thread_pool);
+}
+
+void Universe::advance_motion()
+{
+    if (!m_level.has_motion()) return;
+
+    ORBIT_PROFILE_SCOPE(Motion);
+    m_level.advance_motion(get_delta_time());
+
+    if (!m_navigation.has_context()) return;
+
+    auto const& ctx { m_navigation.get_context() };
+    auto const target_idx { static_cast<uint32_t>(&ctx.target_planet - m_level.get_planets().data()) };
+    sf::Vector2f const displacement { m_level.get_displacement(target_idx) };
+    if (displacement == sf::Vector2f{}) return;
+
+    /* Same as a rebase the other way; the assist rings are drawn round the target, wherever the player is */
+    m_assist.rebase(-displacement);
+
+    /* Inside its target's orbit, the player is carried along with the planet
+     * (and so is what was worked out relative to it); out there, it flies free */
+    if (m_player.is(PlayerState::Exploding) || !m_player.is(PlayerState::SomewhereInsideOrbit)) return;
+
+    m_player.rebase(-displacement);
+    m_prediction.rebase(-displacement);
+    m_launch_solver.carry(-displacement);
+}
+
+void Universe::build_frame_graph()
+{
+    /* Bots only read the level & player; they may run alongside Navigation.
+     * Assist writes the target planet's mass, which the bots read; so it waits on both */
+    auto const swarm { m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Swarm);
+        m_swarm.update();
+    }) };
+
+    auto const navigation { m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Navigation);
+        m_navigation.update();
+    }, {}, TaskAffinity::Caller) };
+
+    /* The player's chain stays on the caller; it publishes navigation events */
+    auto const assist { m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Assist);
+        m_assist.update();
+    }, { navigation, swarm }, TaskAffinity::Caller) };
+
+    auto const orbit { m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Orbit);
+        m_navigation.get_context().target_orbit.update(m_player);
+    }, { assist }, TaskAffinity::Caller) };
+
+    auto const player { m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Player);
+        m_player.update();
+    }, { orbit }, TaskAffinity::Caller) };
+
+    /* Both only read the player's new state */
+    m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(Prediction);
+        m_prediction.update();
+    }, { player });
+
+    m_frame_graph.add([this]
+    {
+        ORBIT_PROFILE_SCOPE(LaunchSolver);
+        m_launch_solver.update();
+    }, { player });
+}
@@ -0,0 +1,42 @@
+#include <cmath>
+#include "Core/WorldOrigin.hpp"
+#include "Core/Log.hpp"
+#include "Core/Trace.hpp"
+#include "Core/Universe.hpp"
+
+void WorldOrigin::update(sf::Vector2f const& focus)
+{
+    if (std::abs(focus.x) <= param_rebase_distance && std::abs(focus.y) <= param_rebase_distance) return;
+
+    sf::Vector2i const offset {
+        static_cast<int>(std::round(focus.x / param_cell_size)),
+        static_cast<int>(std::round(focus.y / param_cell_size)),
+    };
+    rebase_to(m_cell + offset);
+}
+
+void WorldOrigin::rebase_to(sf::Vector2i const& cell)
+{
+    if (cell == m_cell) return;
+    ORBIT_TRACE_INSTANT("rebase");
+
+    /* Whole cells; exact in float (applying it is not; see the header) */
+    sf::Vector2f const shift {
+        static_cast<float>(cell.x - m_cell.x) * param_cell_size,
+        static_cast<float>(cell.y - m_cell.y) * param_cell_size,
+    };
+
+    m_universe.get_level().rebase(shift, cell);
+    m_universe.get_player().rebase(shift);
+    m_universe.get_particles().rebase(shift);
+    m_universe.get_swarm().rebase(shift);
+    m_universe.get_assist().rebase(shift);
+    m_universe.get_launch_solver().rebase(shift);
+    m_universe.get_prediction().rebase(shift);
+    for (auto const& listener : m_listeners) listener(shift);
+
+    m_cell = cell;
+    ++m_rebase_count;
+
+    ORBIT_LOG(Debug, "core/origin") << "rebased to cell (" << cell.x << ", " << cell.y << ")";
+}
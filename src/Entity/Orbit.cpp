@@ -1,34 +1,25 @@
 #include "Entity/Orbit.hpp"
 
-#include "Core/Game.hpp"
-#include "Core/Navigation.hpp"
+#include "Core/Simulation.hpp"
 #include "Entity/PlanetInfo.hpp"
 #include "Entity/Player.hpp"
 #include "Graphics/Window.hpp"
 #include "Math/Vector2.hpp"
 
 Orbit::Orbit(PlanetInfo const& planet, float const radius, sf::Color const& color)
-    : m_state{true}, m_radius{radius}, m_color{color}, m_owner{planet} { init_rings(); }
+    : m_state{true}, m_radius{radius}, m_color{color}, m_owner{planet} {}
 
-void Orbit::init_rings(float const highlight_factor)
+void Orbit::init_rings()
 {
+    if (!m_rings) return; /* Built with the current state once attached */
+
     sf::Color const outline_color { m_color.r, m_color.g, m_color.b, param_visual_ring_outline_alpha };
 
     int n { 1 };
-    for (auto& ring : m_rings)
+    for (auto& ring : *m_rings)
     {
         bool const is_inner_ring { n < param_visual_ring_count };
 
-        float const fill_alpha_coefficient =
-            (m_state)
-            ? (1.0f + highlight_factor * is_inner_ring) // on = inner rings highlighted
-            : 0.4f; // off = 40% alpha
-
-        sf::Color const fill_color {
-            m_color.r, m_color.g, m_color.b,
-            static_cast<std::uint8_t>(param_visual_ring_fill_alpha * fill_alpha_coefficient) // light up effect
-        };
-
         // Use a power function to bunch rings closer to the planet
         float const ratio { static_cast<float>(n) / static_cast<float>(param_visual_ring_count) };
         float const ring_space { m_radius - m_owner.radius };
@@ -48,19 +39,41 @@ void Orbit::init_rings(float const highlight_factor)
         ring.setRadius(current_radius);
         ring.setOrigin({current_radius, current_radius});
         ring.setPosition(get_origin());
-        ring.setFillColor(fill_color);
         ring.setOutlineColor(outline_color);
-        ring.setOutlineThickness(2.0f);
+        ring.setOutlineThickness(param_visual_ring_outline_thickness);
 
         ++n;
     }
+
+    update_ring_fill();
 }
 
-void Orbit::update()
+void Orbit::update_ring_fill(float const highlight_factor)
 {
-    if (!m_state) return;
+    if (!m_rings) return;
+
+    int n { 1 };
+    for (auto& ring : *m_rings)
+    {
+        bool const is_inner_ring { n < param_visual_ring_count };
 
-    auto& player = Game.get_player();
+        float const fill_alpha_coefficient =
+            (m_state)
+            ? (1.0f + highlight_factor * is_inner_ring) // on = inner rings highlighted
+            : 0.4f; // off = 40% alpha
+
+        ring.setFillColor({
+            m_color.r, m_color.g, m_color.b,
+            static_cast<std::uint8_t>(param_visual_ring_fill_alpha * fill_alpha_coefficient) // light up effect
+        });
+
+        ++n;
+    }
+}
+
+void Orbit::update(Player& player)
+{
+    if (!m_state) return;
 
     sf::Vector2f const distance_vec { player.get_distance_vec(m_owner.position) };
     float const distance { distance_vec.length() };
@@ -72,18 +85,16 @@ void Orbit::update()
         param_visual_ring_highlight_clamp,
         1.0f - std::min(1.0f, distance / (param_visual_ring_highlight_factor * m_radius))
         );
-    init_rings(1.5f * param_visual_ring_highlight_factor * highlight_distance_factor);
+    update_ring_fill(1.5f * param_visual_ring_highlight_factor * highlight_distance_factor);
 
     /* Accelerate player */
-    sf::Vector2f const direction { -distance_vec.normalized() };
-    float const force_magnitude { (Navigation::G * m_owner.mass) / (distance * distance) };
-
-    return player.accelerate(direction * force_magnitude);
+    return player.accelerate(Simulation::get_gravity(player.get_position(), m_owner.position, m_owner.mass));
 }
 
 
 void Orbit::draw() const
 {
-    for (auto const& ring : m_rings)
+    if (!m_rings) return;
+    for (auto const& ring : *m_rings)
         Window.draw(ring);
 }
\ No newline at end of file
@@ -3,24 +3,48 @@
 #include "Math/Vector2.hpp"
 
 Planet::Planet(PlanetInfo const& info, Orbit const& orbit)
-    : m_info{info}, m_orbit{orbit} { init_shape(); }
+    : m_info{info}, m_orbit{orbit} { m_orbit.detach_rings(); /* Drawables are not shared */ }
 
 Planet::Planet(
     sf::Vector2f const& position, float const mass, float const radius, sf::Color const& color,
     float const orbit_radius, sf::Color const& orbit_color
     ) : m_info{mass, radius, position, color},
-        m_orbit{m_info, orbit_radius, orbit_color} { init_shape(); }
+        m_orbit{m_info, orbit_radius, orbit_color} {}
 
 void Planet::draw() const
 {
+    if (!m_drawable) return;
     m_orbit.draw();
-    Window.draw(m_shape);
+    Window.draw(m_drawable->shape);
+}
+
+void Planet::set_position(sf::Vector2f const& position)
+{
+    m_info.position = position;
+    if (m_drawable) m_drawable->shape.setPosition(m_info.position);
+    m_orbit.follow_owner();
+}
+
+void Planet::attach_drawable(PlanetDrawable& drawable)
+{
+    m_drawable = &drawable;
+    init_shape();
+    m_orbit.attach_rings(drawable.rings);
+}
+
+PlanetDrawable* Planet::detach_drawable()
+{
+    PlanetDrawable* const drawable { m_drawable };
+    m_drawable = nullptr;
+    m_orbit.detach_rings();
+    return drawable;
 }
 
 void Planet::init_shape()
 {
-    m_shape.setRadius(m_info.radius);
-    m_shape.setOrigin({m_info.radius, m_info.radius});
-    m_shape.setPosition(m_info.position);
-    m_shape.setFillColor(m_info.color);
-}
\ No newline at end of file
+    sf::CircleShape& shape { m_drawable->shape };
+    shape.setRadius(m_info.radius);
+    shape.setOrigin({m_info.radius, m_info.radius});
+    shape.setPosition(m_info.position);
+    shape.setFillColor(m_info.color);
+}
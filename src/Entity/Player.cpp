@@ -1,14 +1,17 @@
-#include <iostream>
-
 #include "Entity/Player.hpp"
 #include "Core/Assist.hpp"
 #include "Core/Collision.hpp"
+#include "Core/Log.hpp"
 #include "Core/Navigation.hpp"
+#include "Core/Profiler.hpp"
+#include "Core/Simulation.hpp"
+#include "Core/Universe.hpp"
 #include "Graphics/Window.hpp"
 #include "Graphics/Particles.hpp"
 #include "Math/Vector2.hpp"
 
-Player::Player()
+Player::Player(Universe& universe)
+    : m_universe{universe}
 {
     // Verlet integration needs the previous position
     m_previous_position = m_position; // aka NULL velocity
@@ -34,8 +37,10 @@ void Player::accelerate(sf::Vector2f const& force)
 
 void Player::explode()
 {
+    static_assert(param_visual_explosion_particle_count <= ParticleEmitter::param_max_particles);
     m_exploding = true;
-    ParticleEmitter.emit(
+    m_universe.get_navigation().on_player_exploded();
+    m_universe.get_particles().emit(
         param_visual_explosion_particle_count,
         m_position
     );
@@ -43,8 +48,7 @@ void Player::explode()
 
 void Player::reset()
 {
-    Random respawn_rand; // FIXME: Probably should not make a new one every time
-    auto& ctx { Navigation.get_context() };
+    auto& ctx { m_universe.get_navigation().get_context() };
 
     /* Respawn when
      * pressing R: at target planet (debug mode only)
@@ -56,11 +60,11 @@ void Player::reset()
     };
     respawn_orbit.turn_on(); // ensure it's on
 
-    const size_t offset_axis { respawn_rand.get<bool>() }; // 0 or 1
+    const size_t offset_axis { m_random.get<bool>() }; // 0 or 1
 
     float vec_buf[2] { 0 };
     vec_buf[offset_axis] = \
-        respawn_rand.sign<float>()
+        m_random.sign<float>()
         * respawn_orbit.get_radius();
 
     set_position(
@@ -69,7 +73,7 @@ void Player::reset()
     ); // at target orbit
 
     vec_buf[!offset_axis] = // tangent axis is opposite
-        respawn_rand.sign<float>()
+        m_random.sign<float>()
         * param_target_orbital_velocity;
     vec_buf[offset_axis] = vec_buf[!offset_axis] * 0.1f; // some radial noise
     set_velocity({
@@ -82,34 +86,37 @@ void Player::reset()
 
 bool Player::is(PlayerState const& state) const
 {
-    auto& ctx { Navigation.get_context() };
+    if (state == PlayerState::Exploding) return m_exploding; /* Changes mid-tick; never cached */
+    return m_universe.get_navigation().get_context().player_state & player_state_mask(state);
+}
 
+PlayerStateMask Player::classify(float const player_error, sf::Vector2f const& player_radial_v)
+{
     auto const& [smoothing_ring_inner_size, smoothing_ring_outer_size] {
         Assist::param_assist_radial_smoothing_ring_region_size
     };
+    constexpr float radial_threshold_sq {
+        Assist::param_assist_radial_smoothing_threshold
+        * Assist::param_assist_radial_smoothing_threshold
+    };
 
-    switch (state)
-    {
-    case PlayerState::FarOutsideOrbit: return (ctx.player_error > param_orbit_far_distance_factor * smoothing_ring_outer_size);
-    case PlayerState::SomewhereOutsideOrbit: return !is(PlayerState::SomewhereInsideOrbit);
-    // case PlayerState::NotInTargetOrbit: return (ctx.player_error > param_orbit_error_tolerance);
-    case PlayerState::NearOutsideOrbit: return is(PlayerState::SomewhereOutsideOrbit)
-                                             & !is(PlayerState::FarOutsideOrbit);
-
-    case PlayerState::InTargetOrbit: return (std::abs(ctx.player_error) <= param_orbit_error_tolerance);
-    case PlayerState::InsideSmoothingRing: return (
-        ctx.player_error > -smoothing_ring_inner_size
-        && is(PlayerState::SomewhereInsideOrbit) //ctx.player_error < smoothing_ring_outer_size
-    );
-    case PlayerState::SomewhereInsideOrbit: return (ctx.player_error < smoothing_ring_outer_size);
-    case PlayerState::InStableOrbit: return is(PlayerState::SomewhereInsideOrbit)
-                                         && ctx.player_radial_v.length()
-                                            < Assist::param_assist_radial_smoothing_threshold;
+    bool const far_outside { player_error > param_orbit_far_distance_factor * smoothing_ring_outer_size };
+    bool const somewhere_inside { player_error < smoothing_ring_outer_size };
 
-    case PlayerState::Exploding: return m_exploding;
+    PlayerStateMask mask { 0 };
+    auto const set { [&mask](PlayerState const state, bool const value)
+                     { if (value) mask |= player_state_mask(state); } };
 
-    default: return false;
-    }
+    set(PlayerState::FarOutsideOrbit, far_outside);
+    set(PlayerState::SomewhereOutsideOrbit, !somewhere_inside);
+    set(PlayerState::NearOutsideOrbit, !somewhere_inside && !far_outside);
+
+    set(PlayerState::SomewhereInsideOrbit, somewhere_inside);
+    set(PlayerState::InsideSmoothingRing, somewhere_inside && player_error > -smoothing_ring_inner_size);
+    set(PlayerState::InTargetOrbit, std::abs(player_error) <= param_orbit_error_tolerance);
+    set(PlayerState::InStableOrbit, somewhere_inside && player_radial_v.lengthSquared() < radial_threshold_sq);
+
+    return mask;
 }
 
 void Player::update()
@@ -119,14 +126,19 @@ void Player::update()
 
     /* NOTE: Using m_core for collision check; may not be accurate since
      * the thrusters are on the outside, but seems to work fine for now */
-    if (!m_exploding && Collision::with_any_planet(m_core))
-        return explode(); /* Particle emitter takes over, blocking main Game::update() loop */
+    bool collided { false };
+    {
+        ORBIT_PROFILE_SCOPE(Collision);
+        collided = !m_exploding && Collision::with_any_planet(m_universe.get_level(), m_core);
+    }
+    if (collided)
+        return explode(); /* Particle emitter takes over, blocking Universe::update() */
 
     /* Particle emitter stopped blocking; reset player and continue gameplay */
     if (is(PlayerState::Exploding))
         reset(); // Not returning; since the player shape needs to be synced after reset
 
-    float const dt { Window.get_delta_time() };
+    float const dt { m_universe.get_delta_time() };
 
     // Clamp velocity
     sf::Vector2f const current_velocity { get_velocity() };
@@ -137,19 +149,14 @@ void Player::update()
         && current_velocity_mag > param_max_drift_velocity
     )
     {
-        std::cout << "[entity/player] [warning] drift velocity clamped: ";
-        std::cout << current_velocity_mag << " -> ";
-
         set_velocity(current_velocity.normalized() * param_max_drift_velocity);
 
-        std::cout << get_velocity().length();
-
+        ORBIT_LOG_EVERY(Warning, "entity/player", param_drift_warning_interval_ms)
+            << "drift velocity clamped: " << current_velocity_mag << " -> " << get_velocity().length();
     }
 
     // Verlet integration
-    sf::Vector2f const current_position { m_position };
-    m_position = 2.0f * current_position - m_previous_position + m_acceleration * (dt * dt);
-    m_previous_position = current_position;
+    Simulation::integrate(m_position, m_previous_position, m_acceleration, dt);
     m_acceleration = {0.0f, 0.0f};
 
     // Sync the drawable shapes
@@ -171,7 +178,7 @@ void Player::update()
 
 sf::Vector2f Player::get_velocity() const
 {
-    float const dt { Window.get_delta_time() };
+    float const dt { m_universe.get_delta_time() };
     return (m_position - m_previous_position) / dt;
 }
 
@@ -199,22 +206,30 @@ void Player::set_velocity(sf::Vector2f const& new_velocity)
 {
     // Since we are using Verlet Integration internally,
     // all we need to do is overwrite m_previous_position
-    float const dt { Window.get_delta_time() };
+    float const dt { m_universe.get_delta_time() };
     m_previous_position = m_position - new_velocity * dt;
     m_acceleration = {0.0f, 0.0f};
 }
 
 sf::Vector2f Player::get_radial_velocity_vector() const
 {
-    auto const& ctx { Navigation.get_context() };
-    auto const& origin { ctx.target_orbit.get_origin() };
+    return get_radial_velocity_vector(m_universe.get_navigation().get_context().target_orbit.get_origin());
+}
+
+sf::Vector2f Player::get_tangential_velocity_vector() const
+{
+    return get_tangential_velocity_vector(m_universe.get_navigation().get_context().target_orbit.get_origin());
+}
+
+sf::Vector2f Player::get_radial_velocity_vector(sf::Vector2f const& origin) const
+{
     sf::Vector2f const radial_direction { get_distance_vec(origin).normalized() };
     return get_velocity().projectedOnto(radial_direction);
 }
 
-sf::Vector2f Player::get_tangential_velocity_vector() const
+sf::Vector2f Player::get_tangential_velocity_vector(sf::Vector2f const& origin) const
 {
-    return get_velocity() - get_radial_velocity_vector();
+    return get_velocity() - get_radial_velocity_vector(origin);
 }
 
 void Player::set_position(sf::Vector2f const& position)
@@ -223,6 +238,39 @@ void Player::set_position(sf::Vector2f const& position)
     m_previous_position = position;
 }
 
+PlayerSnapshot Player::save() const
+{
+    return {
+        .position = m_position,
+        .previous_position = m_previous_position,
+        .acceleration = m_acceleration,
+        .exploding = m_exploding,
+    };
+}
+
+void Player::restore(PlayerSnapshot const& snapshot)
+{
+    m_position = snapshot.position;
+    m_previous_position = snapshot.previous_position;
+    m_acceleration = snapshot.acceleration;
+    m_exploding = snapshot.exploding;
+
+    // Sync the drawable shapes; rotation follows on the next update
+    m_core.setPosition(m_position);
+    for (auto& thruster : m_thrusters)
+        thruster.setPosition(m_position);
+}
+
+void Player::rebase(sf::Vector2f const& shift)
+{
+    m_position -= shift;
+    m_previous_position -= shift;
+
+    m_core.setPosition(m_position);
+    for (auto& thruster : m_thrusters)
+        thruster.setPosition(m_position);
+}
+
 void Player::init_shapes()
 {
     /* Core */
@@ -1,6 +1,50 @@
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include "Core/AllocationTracker.hpp"
 #include "Core/Game.hpp"
 
-int main()
+int main(int const argc, char* argv[])
 {
-    Game.run(); // defined in Game.cpp
-}
\ No newline at end of file
+    GameOptions options;
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        std::string_view const arg { argv[idx] };
+        bool const has_value { idx + 1 < argc };
+
+        if (arg == "--record" && has_value) options.record_path = argv[++idx];
+        else if (arg == "--replay" && has_value) options.replay_path = argv[++idx];
+        else if (arg == "--trace" && has_value) options.trace_path = argv[++idx];
+        else if (arg == "--planets" && has_value)
+        {
+            long const planet_count { std::strtol(argv[++idx], nullptr, 10) };
+            if (planet_count < 1)
+            {
+                std::cout << "main: --planets needs at least 1 planet, got " << argv[idx] << "\n";
+                return 1;
+            }
+            options.level.planet_count = static_cast<uint32_t>(planet_count);
+        }
+        else if (arg == "--extent" && has_value) options.level.extent_scaling_factor = std::strtof(argv[++idx], nullptr);
+        else if (arg == "--padding" && has_value) options.level.planet_padding = std::strtof(argv[++idx], nullptr);
+        else if (arg == "--moons" && has_value) options.level.moon_chance = std::strtof(argv[++idx], nullptr);
+        else if (arg == "--capture" && has_value) options.capture_path = argv[++idx];
+        else if (arg == "--capture-every" && has_value) options.capture_every = std::strtoul(argv[++idx], nullptr, 10);
+        else if (arg == "--capture-raw") options.capture_format = CaptureFormat::Raw;
+        else if (arg == "--headless") options.headless = true;
+        else if (arg == "--uncapped") options.uncapped = true;
+        else if (arg == "--alloc-check") options.allocation_check = true;
+        else
+        {
+            std::cout
+                << "usage: main [--record <file>] [--replay <file>] [--trace <file>] [--headless] [--uncapped]\n"
+                   "            [--planets <count>] [--extent <factor>] [--padding <distance>] [--moons <chance>] [--alloc-check]\n"
+                   "            [--capture <dir> [--capture-every <n>] [--capture-raw]]\n";
+            return 1;
+        }
+    }
+
+    Game game;
+    game.run(options);
+    return AllocationTracker.get_violation_count() > 0;
+}
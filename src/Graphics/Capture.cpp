@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/OpenGL.hpp>
+#include "Graphics/Capture.hpp"
+#include "Graphics/Window.hpp"
+#include "Core/Log.hpp"
+
+Capture::~Capture()
+{
+    if (!m_encoder.joinable()) return;
+
+    {
+        std::lock_guard const lock { m_mutex };
+        m_stopping = true; /* The encoder drains the queue first */
+    }
+    m_condition.notify_one();
+    m_encoder.join();
+}
+
+void Capture::start(std::filesystem::path const& directory, uint32_t const every_nth_frame, CaptureFormat const format)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    m_directory = directory;
+    m_every_nth_frame = std::max(every_nth_frame, 1u);
+    m_format = format;
+}
+
+void Capture::request_screenshot(std::filesystem::path const& directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    m_screenshot_directory = directory;
+    m_screenshot_requested = true;
+}
+
+bool Capture::wants(uint32_t const tick) const
+{
+    return m_screenshot_requested || (is_recording() && tick % m_every_nth_frame == 0);
+}
+
+bool Capture::begin_frame(uint32_t const tick)
+{
+    if (!wants(tick) || !init_texture()) return false;
+
+    m_tick = tick;
+    m_frame_is_screenshot = m_screenshot_requested;
+    if (m_screenshot_requested)
+    {
+        m_screenshot_requested = false;
+        m_frame_format = CaptureFormat::Png;
+        m_frame_directory = m_screenshot_directory;
+    }
+    else
+    {
+        m_frame_format = m_format;
+        m_frame_directory = m_directory;
+    }
+
+    Window.redirect(&*m_texture);
+    return true;
+}
+
+void Capture::end_frame(bool const present)
+{
+    Window.redirect(nullptr);
+    m_texture->display();
+    sf::Texture const& texture { m_texture->getTexture() };
+    ++m_captured_count;
+
+    std::optional<size_t> slot;
+    {
+        std::lock_guard const lock { m_mutex };
+        if (!m_free.empty())
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        }
+    }
+
+    if (!slot) ++m_dropped_count; /* Encoder is behind */
+    else
+    {
+        sf::Vector2u const size { texture.getSize() };
+
+        Frame& frame { m_frames[*slot] };
+        frame.size = size;
+        frame.format = m_frame_format;
+        frame.pixels.resize(static_cast<size_t>(size.x) * size.y * 4); /* Sized once, in init_texture() */
+
+        /* Into the slot's own buffer; nothing in between */
+        (void)m_texture->setActive(true);
+        sf::Texture::bind(&texture);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, frame.pixels.data());
+        sf::Texture::bind(nullptr);
+        (void)m_texture->setActive(false);
+
+        char name[64];
+        if (m_frame_is_screenshot) std::snprintf(name, sizeof(name), "screenshot-%06u-%u.png", m_tick, m_screenshot_count++);
+        else if (m_frame_format == CaptureFormat::Png) std::snprintf(name, sizeof(name), "frame-%06u.png", m_tick);
+        else std::snprintf(name, sizeof(name), "frame-%06u-%ux%u.rgba", m_tick, size.x, size.y);
+        frame.path = m_frame_directory / name;
+
+        {
+            std::lock_guard const lock { m_mutex };
+            m_queue.push_back(*slot);
+        }
+        m_condition.notify_one();
+    }
+
+    if (!present) return;
+
+    /* Same frame in the window */
+    sf::Sprite sprite { texture };
+    sf::Vector2f const resolution { Window.get_internal_resolution() };
+    sf::Vector2f const texture_size { texture.getSize() };
+    sprite.setScale({ resolution.x / texture_size.x, resolution.y / texture_size.y });
+
+    Window.clear();
+    Window.draw_overlay(sprite);
+}
+
+void Capture::flush()
+{
+    std::unique_lock lock { m_mutex };
+    m_idle.wait(lock, [this] { return m_queue.empty() && m_encoding_count == 0; });
+}
+
+uint64_t Capture::get_written_count() const
+{
+    std::lock_guard const lock { m_mutex };
+    return m_written_count;
+}
+
+void Capture::print() const
+{
+    if (m_captured_count == 0) return;
+
+    std::lock_guard const lock { m_mutex };
+    ORBIT_LOG(Info, "graphics/capture")
+        << "captured " << m_captured_count << " frames: " << m_written_count << " written, "
+        << m_dropped_count << " dropped (encoder behind), " << m_failed_count << " failed";
+}
+
+bool Capture::init_texture()
+{
+    if (m_texture) return true;
+    if (m_texture_failed) return false;
+
+    sf::Vector2f const resolution { Window.get_internal_resolution() };
+    sf::Vector2u const size {
+        static_cast<uint32_t>(resolution.x * param_resolution_scale),
+        static_cast<uint32_t>(resolution.y * param_resolution_scale)
+    };
+
+    /* Software renderers may not do multisampled framebuffers */
+    m_texture.emplace();
+    if (!m_texture->resize(size, sf::ContextSettings{0, 0, param_antialiasing_level}) && !m_texture->resize(size))
+    {
+        ORBIT_LOG(Error, "graphics/capture") << "cannot create a " << size.x << "x" << size.y << " render texture";
+        m_texture.reset();
+        m_texture_failed = true;
+        return false;
+    }
+
+    m_free.clear();
+    m_queue.reserve(param_queue_capacity);
+    for (size_t idx = 0; idx < param_queue_capacity; ++idx)
+    {
+        m_frames[idx].pixels.resize(static_cast<size_t>(size.x) * size.y * 4);
+        m_free.push_back(idx);
+    }
+
+    m_encoder = std::thread([this] { encoder_loop(); });
+    return true;
+}
+
+void Capture::encoder_loop()
+{
+    std::unique_lock lock { m_mutex };
+    while (true)
+    {
+        m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty()) return; /* Stopping & drained */
+
+        size_t const slot { m_queue.front() };
+        m_queue.erase(m_queue.begin());
+        ++m_encoding_count;
+
+        lock.unlock();
+        bool const written { write(m_frames[slot]) };
+        lock.lock();
+
+        --m_encoding_count;
+        if (written) ++m_written_count;
+        else ++m_failed_count;
+        m_free.push_back(slot);
+        m_idle.notify_all();
+    }
+}
+
+bool Capture::write(Frame const& frame)
+{
+    if (frame.format == CaptureFormat::Png)
+    {
+        sf::Image image { frame.size, frame.pixels.data() };
+        image.flipVertically();
+        if (image.saveToFile(frame.path)) return true;
+    }
+    else
+    {
+        /* Top row first */
+        std::ofstream file { frame.path, std::ios::binary };
+        size_t const row_bytes { static_cast<size_t>(frame.size.x) * 4 };
+        for (size_t row = frame.size.y; row-- > 0 && file;)
+            file.write(reinterpret_cast<char const*>(frame.pixels.data() + row * row_bytes), static_cast<std::streamsize>(row_bytes));
+
+        if (file) return true;
+    }
+
+    ORBIT_LOG(Error, "graphics/capture") << "cannot write " << frame.path;
+    return false;
+}
@@ -1,26 +1,29 @@
+#include <cassert>
 #include "Graphics/Particles.hpp"
 #include "Core/Collision.hpp"
+#include "Core/FrameArena.hpp"
 #include "Core/Navigation.hpp"
+#include "Core/Universe.hpp"
 #include "Graphics/Window.hpp"
-#include "Graphics/Color.hpp"
 
 void ParticleEmitter::update()
 {
     if (!is_active()) return;
 
-    float const dt { Window.get_delta_time() };
-    auto& ctx { Navigation.get_context() };
+    float const dt { m_universe.get_delta_time() };
+    auto& ctx { m_universe.get_navigation().get_context() };
 
-    for (auto particle = m_particles.begin(); particle != m_particles.end(); )
+    /* Live particles are packed to the front, in order */
+    size_t live { 0 };
+    for (size_t idx = 0; idx < m_count; ++idx)
     {
-        particle->lifetime -= dt;
+        Particle& particle { m_particles[idx] };
+        particle.lifetime -= dt;
 
         if (
-            particle->lifetime <= 0.0f ||
-            Collision::with_planet(ctx.nearest_planet.get_info(), particle->shape)
-        ) {
-            particle = m_particles.erase(particle); continue;
-        }
+            particle.lifetime <= 0.0f ||
+            Collision::with_planet(ctx.nearest_planet.get_info(), particle.shape)
+        ) continue;
 
         /* Simple acceleration:
          * We do not store the position in the particle
@@ -29,55 +32,102 @@ void ParticleEmitter::update()
          * shapes have a limited lifetime anyways,
          * and only managed by this method
          */
-        particle->velocity += param_emit_particle_acceleration * dt;
-        particle->shape.setPosition(
-            particle->shape.getPosition()
-            + particle->velocity * dt
+        particle.velocity += param_emit_particle_acceleration * dt;
+        particle.shape.setPosition(
+            particle.shape.getPosition()
+            + particle.velocity * dt
         );
 
         /* Fade out */
         float const ratio {
-            particle->lifetime /
+            particle.lifetime /
             m_random.get(param_emit_particle_lifetime_dist)
         };
-        sf::Color color { particle->shape.getFillColor() };
+        sf::Color color { particle.shape.getFillColor() };
         color.a = static_cast<uint8_t>(255 * ratio);
-        particle->shape.setFillColor(color);
+        particle.shape.setFillColor(color);
 
-        ++particle;
+        if (live != idx) m_particles[live] = particle; /* Same shape layout; no allocation */
+        ++live;
     }
+    m_count = live;
 }
 
 void ParticleEmitter::draw() const
 {
     if (!is_active()) return;
-    for (auto const& particle : m_particles)
-        Window.draw(particle.shape);
+    for (size_t idx = 0; idx < m_count; ++idx)
+        Window.draw(m_particles[idx].shape);
+}
+
+void ParticleEmitter::save(ParticleSnapshot* const snapshots) const
+{
+    for (size_t idx = 0; idx < m_count; ++idx)
+    {
+        auto const& [velocity, shape, lifetime] { m_particles[idx] };
+        snapshots[idx] = {
+            .velocity = velocity,
+            .position = shape.getPosition(),
+            .size = shape.getSize(),
+            .color = shape.getFillColor(),
+            .lifetime = lifetime,
+        };
+    }
+}
+
+void ParticleEmitter::restore(ParticleSnapshot const* const snapshots, size_t const count)
+{
+    assert(count <= m_particles.size());
+    m_count = count;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        auto& [velocity, shape, lifetime] { m_particles[idx] };
+        velocity = snapshots[idx].velocity;
+        lifetime = snapshots[idx].lifetime;
+        shape.setPosition(snapshots[idx].position);
+        shape.setSize(snapshots[idx].size);
+        shape.setFillColor(snapshots[idx].color);
+    }
 }
 
 void ParticleEmitter::emit(uint32_t const count, sf::Vector2f const& position)
 {
-    m_particles.resize(count);
+    assert(count <= m_particles.size());
+    m_count = count;
 
-    for (auto& [velocity, shape, lifetime] : m_particles)
+    /* One batch per attribute */
+    FrameArena& arena { m_universe.get_frame_arena() };
+    FrameVector<float> values(6 * static_cast<size_t>(count), &arena);
+    FrameVector<sf::Angle> angles(count, &arena);
+    FrameVector<sf::Color> colors(count, &arena);
+    float* const velocity_x { values.data() };
+    float* const velocity_y { velocity_x + count };
+    float* const lifetimes { velocity_y + count };
+    float* const size_x { lifetimes + count };
+    float* const size_y { size_x + count };
+    float* const hue { size_y + count };
+
+    m_random.fill(velocity_x, count, param_emit_particle_velocity_dist.first);
+    m_random.fill(velocity_y, count, param_emit_particle_velocity_dist.second);
+    m_random.fill(angles.data(), count, param_emit_particle_spread_angle_dist);
+    m_random.fill(lifetimes, count, param_emit_particle_lifetime_dist);
+    m_random.fill(size_x, count, param_visual_particle_radius_dist);
+    m_random.fill(size_y, count, param_visual_particle_radius_dist);
+    m_random.fill(hue, count, param_visual_particle_color_hue_dist);
+    param_visual_particle_palette.fill(colors.data(), hue, count);
+
+    for (size_t idx = 0; idx < count; ++idx)
     {
+        auto& [velocity, shape, lifetime] { m_particles[idx] };
+
         /* Emitter */
-        auto const angle {sf::degrees(
-            m_random.get(param_emit_particle_spread_angle_dist)
-        )};
-        velocity = m_random.get(param_emit_particle_velocity_dist).rotatedBy(angle);
-        lifetime = m_random.get(param_emit_particle_lifetime_dist);
+        velocity = sf::Vector2f{velocity_x[idx], velocity_y[idx]}.rotatedBy(angles[idx]);
+        lifetime = lifetimes[idx];
 
         /* Visual */
         shape.setPosition(position);
-        shape.setSize({
-            m_random.get(param_visual_particle_radius_dist),
-            m_random.get(param_visual_particle_radius_dist)
-        });
-        shape.setFillColor(Color::get<Color::HWB>(
-            m_random.get(param_visual_particle_color_hue_dist),
-            param_visual_particle_color_whiteness,
-            param_visual_particle_color_blackness
-        ));
+        shape.setSize({size_x[idx], size_y[idx]});
+        shape.setFillColor(colors[idx]);
     }
 }
@@ -0,0 +1,36 @@
+#include <cmath>
+#include "Math/Kepler.hpp"
+
+float KeplerOrbit::get_mean_motion(float const gravitational_parameter, float const semi_major_axis)
+{
+    return std::sqrt(gravitational_parameter / (semi_major_axis * semi_major_axis * semi_major_axis));
+}
+
+sf::Vector2f KeplerOrbit::get_offset(double const time) const
+{
+    /* Reduced in double; a float would lose the fraction after a few hours */
+    constexpr double two_pi { 6.283185307179586 };
+    double const mean_anomaly_full { static_cast<double>(mean_anomaly_at_epoch) + static_cast<double>(mean_motion) * time };
+    auto const mean_anomaly { static_cast<float>(std::fmod(mean_anomaly_full, two_pi)) };
+
+    /* M = E - e sin(E), for the eccentric anomaly E */
+    float const e { eccentricity };
+    float eccentric_anomaly { mean_anomaly + e * std::sin(mean_anomaly) };
+    for (uint32_t step = 0; step < param_solver_iterations; ++step)
+    {
+        eccentric_anomaly -=
+            (eccentric_anomaly - e * std::sin(eccentric_anomaly) - mean_anomaly)
+            / (1.0f - e * std::cos(eccentric_anomaly));
+    }
+
+    /* In the orbit's own frame (periapsis on +x), then rotated into place */
+    float const semi_minor_axis { semi_major_axis * std::sqrt(1.0f - e * e) };
+    sf::Vector2f const local {
+        semi_major_axis * (std::cos(eccentric_anomaly) - e),
+        semi_minor_axis * std::sin(eccentric_anomaly)
+    };
+
+    float const cos_w { std::cos(periapsis_angle) };
+    float const sin_w { std::sin(periapsis_angle) };
+    return { local.x * cos_w - local.y * sin_w, local.x * sin_w + local.y * cos_w };
+}
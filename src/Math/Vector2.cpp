@@ -0,0 +1,344 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "Math/Vector2.hpp"
+
+#if defined(__AVX2__)
+#define ORBIT_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORBIT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr float infinity { std::numeric_limits<float>::infinity() };
+
+#if defined(ORBIT_SIMD_AVX2)
+
+    /* Thin wrappers, so that the kernels below read the same for every width */
+    struct Lanes
+    {
+        using Float = __m256;
+        using Int = __m256i;
+        constexpr static size_t width { 8 };
+        constexpr static char const* name { "avx2" };
+
+        static Float load(float const* const ptr) { return _mm256_loadu_ps(ptr); }
+        static void store(float* const ptr, Float const v) { _mm256_storeu_ps(ptr, v); }
+        static Float set(float const v) { return _mm256_set1_ps(v); }
+        static Int set(int32_t const v) { return _mm256_set1_epi32(v); }
+        static Int iota(int32_t const v) { return _mm256_setr_epi32(v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, v + 7); }
+
+        static Float add(Float const a, Float const b) { return _mm256_add_ps(a, b); }
+        static Int add(Int const a, Int const b) { return _mm256_add_epi32(a, b); }
+        static Float sub(Float const a, Float const b) { return _mm256_sub_ps(a, b); }
+        static Float mul(Float const a, Float const b) { return _mm256_mul_ps(a, b); }
+        static Float div(Float const a, Float const b) { return _mm256_div_ps(a, b); }
+        static Float sqrt(Float const a) { return _mm256_sqrt_ps(a); }
+
+        static Float less(Float const a, Float const b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Float equal(Int const a, Int const b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+        static Float both(Float const a, Float const b) { return _mm256_and_ps(a, b); }
+        static Float but_not(Float const a, Float const b) { return _mm256_andnot_ps(b, a); } /* a & ~b */
+
+        /* mask ? a : b */
+        static Float select(Float const mask, Float const a, Float const b) { return _mm256_blendv_ps(b, a, mask); }
+        static Int select(Float const mask, Int const a, Int const b)
+        { return _mm256_blendv_epi8(b, a, _mm256_castps_si256(mask)); }
+
+        static int bits(Float const mask) { return _mm256_movemask_ps(mask); }
+
+        /* bytes != 0 */
+        static Float load_mask(uint8_t const* const ptr)
+        {
+            Int const widened { _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(ptr))) };
+            return _mm256_xor_ps(equal(widened, set(0)), _mm256_castsi256_ps(set(-1)));
+        }
+
+        static void store(int32_t* const ptr, Int const v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v); }
+    };
+
+#elif defined(ORBIT_SIMD_SSE2)
+
+    struct Lanes
+    {
+        using Float = __m128;
+        using Int = __m128i;
+        constexpr static size_t width { 4 };
+        constexpr static char const* name { "sse2" };
+
+        static Float load(float const* const ptr) { return _mm_loadu_ps(ptr); }
+        static void store(float* const ptr, Float const v) { _mm_storeu_ps(ptr, v); }
+        static Float set(float const v) { return _mm_set1_ps(v); }
+        static Int set(int32_t const v) { return _mm_set1_epi32(v); }
+        static Int iota(int32_t const v) { return _mm_setr_epi32(v, v + 1, v + 2, v + 3); }
+
+        static Float add(Float const a, Float const b) { return _mm_add_ps(a, b); }
+        static Int add(Int const a, Int const b) { return _mm_add_epi32(a, b); }
+        static Float sub(Float const a, Float const b) { return _mm_sub_ps(a, b); }
+        static Float mul(Float const a, Float const b) { return _mm_mul_ps(a, b); }
+        static Float div(Float const a, Float const b) { return _mm_div_ps(a, b); }
+        static Float sqrt(Float const a) { return _mm_sqrt_ps(a); }
+
+        static Float less(Float const a, Float const b) { return _mm_cmplt_ps(a, b); }
+        static Float equal(Int const a, Int const b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+        static Float both(Float const a, Float const b) { return _mm_and_ps(a, b); }
+        static Float but_not(Float const a, Float const b) { return _mm_andnot_ps(b, a); } /* a & ~b */
+
+        /* mask ? a : b; no blendv before SSE4.1 */
+        static Float select(Float const mask, Float const a, Float const b)
+        { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static Int select(Float const mask, Int const a, Int const b)
+        {
+            Int const m { _mm_castps_si128(mask) };
+            return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+        }
+
+        static int bits(Float const mask) { return _mm_movemask_ps(mask); }
+
+        /* bytes != 0 */
+        static Float load_mask(uint8_t const* const ptr)
+        {
+            int32_t packed;
+            std::memcpy(&packed, ptr, sizeof(packed));
+            Int const zero { _mm_setzero_si128() };
+            Int const widened { _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero) };
+            return _mm_xor_ps(equal(widened, zero), _mm_castsi128_ps(set(-1)));
+        }
+
+        static void store(int32_t* const ptr, Int const v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v); }
+    };
+
+#endif
+
+#if defined(ORBIT_SIMD_AVX2) || defined(ORBIT_SIMD_SSE2)
+#define ORBIT_SIMD
+    constexpr size_t width { Lanes::width };
+#endif
+
+    [[nodiscard]] int lowest_bit(int const bits)
+    {
+        int bit { 0 };
+        while (!(bits & (1 << bit))) ++bit;
+        return bit;
+    }
+}
+
+char const* Vector2Batch::get_backend()
+{
+#ifdef ORBIT_SIMD
+    return Lanes::name;
+#else
+    return "scalar";
+#endif
+}
+
+void Vector2Batch::length_squared(Vector2ConstSpan const v, float* const out)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    for (; idx + width <= v.size; idx += width)
+    {
+        auto const x { Lanes::load(v.x + idx) };
+        auto const y { Lanes::load(v.y + idx) };
+        Lanes::store(out + idx, Lanes::add(Lanes::mul(x, x), Lanes::mul(y, y)));
+    }
+#endif
+    for (; idx < v.size; ++idx) out[idx] = v.x[idx] * v.x[idx] + v.y[idx] * v.y[idx];
+}
+
+void Vector2Batch::distance_squared(Vector2ConstSpan const points, sf::Vector2f const& from, float* const out)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    auto const from_x { Lanes::set(from.x) };
+    auto const from_y { Lanes::set(from.y) };
+    for (; idx + width <= points.size; idx += width)
+    {
+        auto const dx { Lanes::sub(Lanes::load(points.x + idx), from_x) };
+        auto const dy { Lanes::sub(Lanes::load(points.y + idx), from_y) };
+        Lanes::store(out + idx, Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)));
+    }
+#endif
+    for (; idx < points.size; ++idx)
+    {
+        float const dx { points.x[idx] - from.x };
+        float const dy { points.y[idx] - from.y };
+        out[idx] = dx * dx + dy * dy;
+    }
+}
+
+void Vector2Batch::dot(Vector2ConstSpan const a, Vector2ConstSpan const b, float* const out)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    for (; idx + width <= a.size; idx += width)
+    {
+        Lanes::store(out + idx, Lanes::add(
+            Lanes::mul(Lanes::load(a.x + idx), Lanes::load(b.x + idx)),
+            Lanes::mul(Lanes::load(a.y + idx), Lanes::load(b.y + idx))
+        ));
+    }
+#endif
+    for (; idx < a.size; ++idx) out[idx] = a.x[idx] * b.x[idx] + a.y[idx] * b.y[idx];
+}
+
+void Vector2Batch::normalize(Vector2Span const v)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    auto const zero { Lanes::set(0.0f) };
+    for (; idx + width <= v.size; idx += width)
+    {
+        auto const x { Lanes::load(v.x + idx) };
+        auto const y { Lanes::load(v.y + idx) };
+        auto const length_sq { Lanes::add(Lanes::mul(x, x), Lanes::mul(y, y)) };
+        auto const nonzero { Lanes::less(zero, length_sq) };
+        auto const length { Lanes::sqrt(length_sq) };
+
+        Lanes::store(v.x + idx, Lanes::select(nonzero, Lanes::div(x, length), zero));
+        Lanes::store(v.y + idx, Lanes::select(nonzero, Lanes::div(y, length), zero));
+    }
+#endif
+    for (; idx < v.size; ++idx)
+    {
+        float const length_sq { v.x[idx] * v.x[idx] + v.y[idx] * v.y[idx] };
+        if (!(0.0f < length_sq)) { v.x[idx] = v.y[idx] = 0.0f; continue; }
+
+        float const length { std::sqrt(length_sq) };
+        v.x[idx] = v.x[idx] / length;
+        v.y[idx] = v.y[idx] / length;
+    }
+}
+
+void Vector2Batch::project(Vector2ConstSpan const v, Vector2ConstSpan const onto, Vector2Span const out)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    auto const zero { Lanes::set(0.0f) };
+    for (; idx + width <= v.size; idx += width)
+    {
+        auto const ox { Lanes::load(onto.x + idx) };
+        auto const oy { Lanes::load(onto.y + idx) };
+        auto const onto_sq { Lanes::add(Lanes::mul(ox, ox), Lanes::mul(oy, oy)) };
+        auto const along {
+            Lanes::add(Lanes::mul(Lanes::load(v.x + idx), ox), Lanes::mul(Lanes::load(v.y + idx), oy))
+        };
+        auto const nonzero { Lanes::less(zero, onto_sq) };
+        auto const factor { Lanes::select(nonzero, Lanes::div(along, onto_sq), zero) };
+
+        Lanes::store(out.x + idx, Lanes::mul(ox, factor));
+        Lanes::store(out.y + idx, Lanes::mul(oy, factor));
+    }
+#endif
+    for (; idx < v.size; ++idx)
+    {
+        float const onto_sq { onto.x[idx] * onto.x[idx] + onto.y[idx] * onto.y[idx] };
+        float const along { v.x[idx] * onto.x[idx] + v.y[idx] * onto.y[idx] };
+        float const factor { (0.0f < onto_sq) ? along / onto_sq : 0.0f };
+
+        out.x[idx] = onto.x[idx] * factor;
+        out.y[idx] = onto.y[idx] * factor;
+    }
+}
+
+Vector2Nearest Vector2Batch::nearest(
+    Vector2ConstSpan const points, sf::Vector2f const& from,
+    uint8_t const* const mask, uint32_t const exclude
+)
+{
+    Vector2Nearest result { npos, infinity };
+    size_t idx { 0 };
+
+#ifdef ORBIT_SIMD
+    if (points.size >= width)
+    {
+        /* Per lane minimum (first one within the lane), then across lanes */
+        auto const from_x { Lanes::set(from.x) };
+        auto const from_y { Lanes::set(from.y) };
+        auto const excluded { Lanes::set(static_cast<int32_t>(exclude)) };
+        auto const step { Lanes::set(static_cast<int32_t>(width)) };
+
+        auto best { Lanes::set(infinity) };
+        auto best_index { Lanes::set(static_cast<int32_t>(npos)) };
+        auto index { Lanes::iota(0) };
+
+        for (; idx + width <= points.size; idx += width)
+        {
+            auto const dx { Lanes::sub(Lanes::load(points.x + idx), from_x) };
+            auto const dy { Lanes::sub(Lanes::load(points.y + idx), from_y) };
+            auto const distance_sq { Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)) };
+
+            auto take { Lanes::but_not(Lanes::less(distance_sq, best), Lanes::equal(index, excluded)) };
+            if (mask) take = Lanes::both(take, Lanes::load_mask(mask + idx));
+
+            best = Lanes::select(take, distance_sq, best);
+            best_index = Lanes::select(take, index, best_index);
+            index = Lanes::add(index, step);
+        }
+
+        float lane_best[width];
+        int32_t lane_index[width];
+        Lanes::store(lane_best, best);
+        Lanes::store(lane_index, best_index);
+
+        for (size_t lane = 0; lane < width; ++lane)
+        {
+            auto const candidate { static_cast<uint32_t>(lane_index[lane]) };
+            if (candidate == npos) continue;
+
+            bool const nearer {
+                lane_best[lane] < result.distance_squared
+                || (lane_best[lane] == result.distance_squared && candidate < result.index)
+            };
+            if (nearer) result = { candidate, lane_best[lane] };
+        }
+    }
+#endif
+
+    /* Later indices than any lane saw; strictly nearer only */
+    for (; idx < points.size; ++idx)
+    {
+        if (idx == exclude || (mask && !mask[idx])) continue;
+
+        float const dx { points.x[idx] - from.x };
+        float const dy { points.y[idx] - from.y };
+        float const distance_sq { dx * dx + dy * dy };
+        if (distance_sq < result.distance_squared) result = { static_cast<uint32_t>(idx), distance_sq };
+    }
+
+    if (result.index == npos) result.distance_squared = 0.0f;
+    return result;
+}
+
+uint32_t Vector2Batch::first_within(
+    Vector2ConstSpan const points, float const* const radii, float const padding, sf::Vector2f const& from
+)
+{
+    size_t idx { 0 };
+#ifdef ORBIT_SIMD
+    auto const from_x { Lanes::set(from.x) };
+    auto const from_y { Lanes::set(from.y) };
+    auto const pad { Lanes::set(padding) };
+    for (; idx + width <= points.size; idx += width)
+    {
+        auto const dx { Lanes::sub(Lanes::load(points.x + idx), from_x) };
+        auto const dy { Lanes::sub(Lanes::load(points.y + idx), from_y) };
+        auto const distance_sq { Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)) };
+        auto const radius { Lanes::add(Lanes::load(radii + idx), pad) };
+
+        if (int const hits { Lanes::bits(Lanes::less(distance_sq, Lanes::mul(radius, radius))) })
+            return static_cast<uint32_t>(idx + lowest_bit(hits));
+    }
+#endif
+    for (; idx < points.size; ++idx)
+    {
+        float const dx { points.x[idx] - from.x };
+        float const dy { points.y[idx] - from.y };
+        float const radius { radii[idx] + padding };
+        if (dx * dx + dy * dy < radius * radius) return static_cast<uint32_t>(idx);
+    }
+    return npos;
+}